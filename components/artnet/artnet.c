@@ -8,6 +8,8 @@ void artnet_init_stats(struct artnet *artnet)
   stats_timer_init(&artnet->stats.recv);
 
   stats_counter_init(&artnet->stats.recv_error);
+  stats_gauge_init(&artnet->stats.recv_backlog);
+  stats_counter_init(&artnet->stats.recv_overrun);
   stats_counter_init(&artnet->stats.recv_poll);
   stats_counter_init(&artnet->stats.recv_dmx);
   stats_counter_init(&artnet->stats.recv_sync);
@@ -15,6 +17,14 @@ void artnet_init_stats(struct artnet *artnet)
   stats_counter_init(&artnet->stats.recv_invalid);
   stats_counter_init(&artnet->stats.errors);
   stats_counter_init(&artnet->stats.dmx_discard);
+  stats_counter_init(&artnet->stats.dmx_miss);
+  stats_counter_init(&artnet->stats.send_sync);
+  stats_counter_init(&artnet->stats.send_error);
+
+  stats_timer_init(&artnet->stats.poll);
+  stats_counter_init(&artnet->stats.poll_build);
+  stats_counter_init(&artnet->stats.poll_drop);
+  stats_counter_init(&artnet->stats.send_poll_reply);
 }
 
 int artnet_init(struct artnet *artnet, struct artnet_options options)
@@ -35,11 +45,16 @@ int artnet_init(struct artnet *artnet, struct artnet_options options)
 
   artnet_init_stats(artnet);
 
-  if ((err = artnet_listen(&artnet->socket, options.port))) {
+  if ((err = artnet_listen(&artnet->socket, options.port, options.recv_buffer))) {
     LOG_ERROR("artnet_listen port=%u", options.port);
     return err;
   }
 
+  if ((err = artnet_transmit_init(artnet))) {
+    LOG_ERROR("artnet_transmit_init");
+    return err;
+  }
+
   if (options.inputs) {
     artnet->input_size = options.inputs;
 
@@ -68,6 +83,11 @@ int artnet_init(struct artnet *artnet, struct artnet_options options)
     }
   }
 
+  if ((err = artnet_poll_init(artnet))) {
+    LOG_ERROR("artnet_poll_init");
+    return err;
+  }
+
   return 0;
 }
 
@@ -104,12 +124,27 @@ bool artnet_get_inputs_enabled(struct artnet *artnet)
 
 int artnet_set_metadata(struct artnet *artnet, const struct artnet_metadata *metadata)
 {
-  // XXX: locking for artnet_send_poll_reply()?
-  artnet->options.metadata = *metadata;
+  artnet_poll_set_metadata(artnet, metadata);
 
   return 0;
 }
 
+/* Sample socket receive buffer usage after each received packet */
+static void artnet_recv_stats(struct artnet *artnet)
+{
+  int backlog;
+
+  if (artnet_recv_backlog(artnet->socket, &backlog)) {
+    return;
+  }
+
+  stats_gauge_sample(&artnet->stats.recv_backlog, backlog);
+
+  if (artnet->options.recv_buffer && backlog + sizeof(artnet->packet) > artnet->options.recv_buffer) {
+    stats_counter_increment(&artnet->stats.recv_overrun);
+  }
+}
+
 int artnet_listen_main(struct artnet *artnet)
 {
   int err;
@@ -128,6 +163,8 @@ int artnet_listen_main(struct artnet *artnet)
       continue;
     }
 
+    artnet_recv_stats(artnet);
+
     WITH_STATS_TIMER(&artnet->stats.recv) {
       if ((err = artnet_sendrecv(artnet, &sendrecv)) < 0) {
         LOG_ERROR("artnet_sendrecv");
@@ -152,6 +189,8 @@ void artnet_get_stats(struct artnet *artnet, struct artnet_stats *stats)
   stats->recv = stats_timer_copy(&artnet->stats.recv);
 
   stats->recv_error = stats_counter_copy(&artnet->stats.recv_error);
+  stats->recv_backlog = stats_gauge_copy(&artnet->stats.recv_backlog);
+  stats->recv_overrun = stats_counter_copy(&artnet->stats.recv_overrun);
   stats->recv_poll = stats_counter_copy(&artnet->stats.recv_poll);
   stats->recv_dmx = stats_counter_copy(&artnet->stats.recv_dmx);
   stats->recv_sync = stats_counter_copy(&artnet->stats.recv_sync);
@@ -159,6 +198,14 @@ void artnet_get_stats(struct artnet *artnet, struct artnet_stats *stats)
   stats->recv_invalid = stats_counter_copy(&artnet->stats.recv_invalid);
   stats->errors = stats_counter_copy(&artnet->stats.errors);
   stats->dmx_discard = stats_counter_copy(&artnet->stats.dmx_discard);
+  stats->dmx_miss = stats_counter_copy(&artnet->stats.dmx_miss);
+  stats->send_sync = stats_counter_copy(&artnet->stats.send_sync);
+  stats->send_error = stats_counter_copy(&artnet->stats.send_error);
+
+  stats->poll = stats_timer_copy(&artnet->stats.poll);
+  stats->poll_build = stats_counter_copy(&artnet->stats.poll_build);
+  stats->poll_drop = stats_counter_copy(&artnet->stats.poll_drop);
+  stats->send_poll_reply = stats_counter_copy(&artnet->stats.send_poll_reply);
 }
 
 // node in synchronous DMX mode?
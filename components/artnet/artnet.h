@@ -12,6 +12,7 @@
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <freertos/semphr.h>
 #include <freertos/task.h>
 #include <lwip/sockets.h>
 
@@ -24,7 +25,8 @@ struct artnet_sendrecv {
   size_t len;
 };
 
-int artnet_listen(int *sockp, uint16_t port);
+int artnet_listen(int *sockp, uint16_t port, unsigned recv_buffer);
+int artnet_recv_backlog(int sock, int *backlogp);
 int artnet_send(int sock, const struct artnet_sendrecv *send);
 int artnet_recv(int sock, struct artnet_sendrecv *recv);
 
@@ -39,6 +41,10 @@ struct artnet_input {
 
   xQueueHandle queue;
 
+  // prepared ArtDmx header, with last transmitted data
+  union artnet_packet *transmit_packet;
+  TickType_t transmit_tick;
+
   struct artnet_input_stats stats;
 };
 
@@ -65,6 +71,36 @@ void artnet_reset_outputs_stats(struct artnet *artnet);
 /* protocol.c */
 int artnet_sendrecv(struct artnet *artnet, struct artnet_sendrecv *sendrecv);
 
+/* poll.c */
+#define ARTNET_POLL_QUEUE_SIZE 4
+
+// input ports are reported as receiving data for 4s after the last update
+#define ARTNET_POLL_INPUT_TICKS (4000 / portTICK_PERIOD_MS)
+
+struct artnet_poll_request {
+  struct sockaddr addr;
+  socklen_t addrlen;
+};
+
+struct artnet_poll_reply {
+  struct artnet_packet_poll_reply packet;
+
+  // patched input ports, for live good_input status
+  struct artnet_input *inputs[4];
+  unsigned input_count;
+};
+
+int artnet_poll_init(struct artnet *artnet);
+void artnet_poll_invalidate(struct artnet *artnet);
+void artnet_poll_set_metadata(struct artnet *artnet, const struct artnet_metadata *metadata);
+int artnet_poll_request(struct artnet *artnet, const struct artnet_sendrecv *recv);
+
+/* transmit.c */
+int artnet_transmit_init(struct artnet *artnet);
+int artnet_transmit_init_input(struct artnet *artnet, struct artnet_input *input);
+int artnet_transmit_dmx(struct artnet *artnet, struct artnet_input *input, const struct artnet_dmx *dmx);
+int artnet_transmit_sync(struct artnet *artnet);
+
 /* artnet.c */
 struct artnet {
   struct artnet_options options;
@@ -84,6 +120,18 @@ struct artnet {
   EventGroupHandle_t input_events;
   struct artnet_dmx *input_dmx;
 
+  /* transmit */
+  struct sockaddr_in transmit_addrs[ARTNET_TRANSMIT_ADDRESSES_MAX];
+  unsigned transmit_addr_count;
+  struct artnet_packet_sync transmit_sync;
+
+  /* poll */
+  xQueueHandle poll_queue;
+  SemaphoreHandle_t poll_mutex;
+  struct artnet_poll_reply *poll_replies;
+  unsigned poll_reply_size, poll_reply_count;
+  bool poll_valid;
+
   // last sync received at
   TickType_t sync_tick;
 
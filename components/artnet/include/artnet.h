@@ -30,6 +30,8 @@
 #define ARTNET_INPUTS_MAX 16
 #define ARTNET_INPUT_EVENT_BITS 0x00ffffff
 
+#define ARTNET_TRANSMIT_ADDRESSES_MAX 4
+
 struct artnet;
 struct artnet_input;
 struct artnet_output;
@@ -38,6 +40,9 @@ struct artnet_options {
   // UDP used for listen()
   uint16_t port;
 
+  // socket receive buffer size in bytes, or 0 for the lwIP default
+  unsigned recv_buffer;
+
   // metadata used for poll reply, not listen()
   struct artnet_metadata {
     uint8_t ip_address[4];
@@ -52,6 +57,21 @@ struct artnet_options {
 
   // number of output ports supported
   unsigned outputs;
+
+  // transmit ArtDmx on the network for input ports
+  struct artnet_transmit_options {
+    bool enabled;
+
+    // unicast or directed broadcast addresses, limited broadcast if none
+    uint8_t addresses[ARTNET_TRANSMIT_ADDRESSES_MAX][4];
+    unsigned address_count;
+
+    // send ArtSync after each batch of ArtDmx
+    bool sync;
+
+    // skip unchanged ArtDmx until this many ticks since the last send, 0 to always send
+    TickType_t keepalive_ticks;
+  } transmit;
 };
 
 struct artnet_dmx {
@@ -174,6 +194,7 @@ struct artnet_input_state artnet_input_state(struct artnet_input *artnet_input);
  *
  * dmx->len must be set correctly.
  *
+ * Patched to any matching local outputs, and transmitted on the network if enabled in artnet_options.transmit.
  */
 void artnet_input_dmx(struct artnet_input *input, const struct artnet_dmx *dmx);
 
@@ -316,9 +337,20 @@ int artnet_sync_outputs(struct artnet *artnet);
  */
 int artnet_listen_main(struct artnet *artnet);
 
+/** Run artnet poll reply mainloop.
+ *
+ * ArtPoll packets received by artnet_listen_main() are queued for this task, and replied to using cached ArtPollReply packets.
+ * The cached packets are rebuilt after artnet_add_input(), artnet_add_output() or artnet_set_metadata().
+ *
+ * Should run at a lower priority than artnet_listen_main(), to avoid delaying ArtDmx processing.
+ */
+int artnet_poll_main(struct artnet *artnet);
+
 /** Run artnet input mainloop.
  *
  * Only necessary if any artnet inputs are patched.
+ *
+ * Updated inputs are processed in batches, followed by an ArtSync if transmitting.
  */
 int artnet_inputs_main(struct artnet *artnet);
 
@@ -10,6 +10,12 @@ struct artnet_stats {
   /* Failed to receive ArtNet packet. */
   struct stats_counter recv_error;
 
+  /* Bytes still queued in the socket receive buffer after each received packet */
+  struct stats_gauge recv_backlog;
+
+  /* Socket receive buffer too full to queue another maximum-size packet, further packets will be dropped */
+  struct stats_counter recv_overrun;
+
   /* Received ArtPoll packets */
   struct stats_counter recv_poll;
 
@@ -31,6 +37,26 @@ struct artnet_stats {
   /* Discarded ArtDmx packets, no output found */
   struct stats_counter dmx_discard;
 
+  /* Missed ArtDmx packets across all outputs, counted from sequence gaps */
+  struct stats_counter dmx_miss;
+
+  /* Transmitted ArtSync packets */
+  struct stats_counter send_sync;
+
+  /* Failed to transmit ArtNet packet, from both the poll and inputs tasks */
+  struct stats_counter send_error;
+
+  /* Complete ArtPoll -> ArtPollReply handling */
+  struct stats_timer poll;
+
+  /* Rebuilt cached ArtPollReply packets after patch/metadata changes */
+  struct stats_counter poll_build;
+
+  /* Dropped ArtPoll packets, poll queue full */
+  struct stats_counter poll_drop;
+
+  /* Transmitted ArtPollReply packets */
+  struct stats_counter send_poll_reply;
 };
 
 struct artnet_input_stats {
@@ -39,6 +65,12 @@ struct artnet_input_stats {
 
   /* Output queue overflowed, previous packet overwritten */
   struct stats_counter queue_overflow;
+
+  /* Transmitted ArtDMX packets */
+  struct stats_counter dmx_send;
+
+  /* Unchanged ArtDMX packets not transmitted */
+  struct stats_counter dmx_skip;
 };
 
 struct artnet_output_stats {
@@ -6,6 +6,8 @@ static void init_input_stats(struct artnet_input_stats *stats)
 {
   stats_counter_init(&stats->dmx_recv);
   stats_counter_init(&stats->queue_overflow);
+  stats_counter_init(&stats->dmx_send);
+  stats_counter_init(&stats->dmx_skip);
 }
 
 int artnet_add_input(struct artnet *artnet, struct artnet_input **inputp, struct artnet_input_options options)
@@ -35,6 +37,13 @@ int artnet_add_input(struct artnet *artnet, struct artnet_input **inputp, struct
 
   init_input_stats(&input->stats);
 
+  if (artnet_transmit_init_input(artnet, input)) {
+    LOG_ERROR("artnet_transmit_init_input");
+    return -1;
+  }
+
+  artnet_poll_invalidate(artnet);
+
   *inputp = input;
 
   return 0;
@@ -76,6 +85,7 @@ int artnet_inputs_main(struct artnet *artnet)
     BaseType_t xWaitForAllBits = false;
 
     EventBits_t event_bits = xEventGroupWaitBits(artnet->input_events, ARTNET_INPUT_EVENT_BITS, xClearOnExit, xWaitForAllBits, portMAX_DELAY);
+    unsigned transmit_count = 0;
 
     for (unsigned index = 0; index < artnet->input_count; index++) {
       struct artnet_input *input = &artnet->input_ports[index];
@@ -89,11 +99,22 @@ int artnet_inputs_main(struct artnet *artnet)
         continue;
       }
 
+      if (artnet_transmit_dmx(artnet, input, artnet->input_dmx) == 0) {
+        transmit_count++;
+      }
+
       if (artnet_outputs_dmx(artnet, input->options.address, artnet->input_dmx)) {
         LOG_WARN("artnet_outputs_dmx");
         continue;
       }
     }
+
+    // end of batch
+    if (transmit_count && artnet->options.transmit.sync) {
+      if (artnet_transmit_sync(artnet)) {
+        LOG_WARN("artnet_transmit_sync");
+      }
+    }
   }
 }
 
@@ -164,6 +185,8 @@ int artnet_get_input_stats(struct artnet *artnet, int index, struct artnet_input
 
   stats->dmx_recv = stats_counter_copy(&input->stats.dmx_recv);
   stats->queue_overflow = stats_counter_copy(&input->stats.queue_overflow);
+  stats->dmx_send = stats_counter_copy(&input->stats.dmx_send);
+  stats->dmx_skip = stats_counter_copy(&input->stats.dmx_skip);
 
   return 0;
 }
@@ -6,7 +6,7 @@
 #include <string.h>
 #include <lwip/sockets.h>
 
-int artnet_listen(int *sockp, uint16_t port)
+int artnet_listen(int *sockp, uint16_t port, unsigned recv_buffer)
 {
   struct sockaddr_in bind_addr = {
     .sin_family = AF_INET,
@@ -20,13 +20,29 @@ int artnet_listen(int *sockp, uint16_t port)
     return -1;
   }
 
+  if (!recv_buffer) {
+    // lwIP default
+  } else {
+#if LWIP_SO_RCVBUF
+    int size = recv_buffer;
+
+    if (setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) < 0) {
+      LOG_ERROR("setsockopt(SO_RCVBUF): %s", strerror(errno));
+      close(sock);
+      return -1;
+    }
+#else
+    LOG_WARN("recv_buffer=%u not supported without CONFIG_LWIP_SO_RCVBUF", recv_buffer);
+#endif
+  }
+
   if (bind(sock, (struct sockaddr *) &bind_addr, sizeof(bind_addr)) < 0) {
     LOG_ERROR("bind: %s", strerror(errno));
     close(sock);
     return -1;
   }
 
-  LOG_INFO("port=%u: socket=%d", port, sock);
+  LOG_INFO("port=%u: socket=%d recv_buffer=%u", port, sock, recv_buffer);
 
   *sockp = sock;
 
@@ -45,6 +61,20 @@ int artnet_send(int sock, const struct artnet_sendrecv *send)
   return 0;
 }
 
+int artnet_recv_backlog(int sock, int *backlogp)
+{
+#if LWIP_SO_RCVBUF
+  if (ioctl(sock, FIONREAD, backlogp) < 0) {
+    LOG_ERROR("ioctl(FIONREAD): %s", strerror(errno));
+    return -1;
+  }
+
+  return 0;
+#else
+  return 1;
+#endif
+}
+
 int artnet_recv(int sock, struct artnet_sendrecv *recv)
 {
   int ret;
@@ -51,6 +51,8 @@ int artnet_add_output(struct artnet *artnet, struct artnet_output **outputp, str
 
   init_output_stats(&output->stats);
 
+  artnet_poll_invalidate(artnet);
+
   *outputp = output;
 
   return 0;
@@ -187,8 +189,15 @@ void artnet_output_dmx(struct artnet_output *output, struct artnet_dmx *dmx)
     stats_counter_increment(&output->stats.seq_good);
 
   } else if (dmx->seq > output->state.seq || output->state.seq - dmx->seq >= 128) {
-    // missed
+    // missed, seq 0 is skipped on wraparound
+    uint8_t missed = dmx->seq - output->state.seq - 1;
+
+    if (dmx->seq < output->state.seq) {
+      missed--;
+    }
+
     stats_counter_increment(&output->stats.seq_miss);
+    stats_counter_add(&output->artnet->stats.dmx_miss, missed);
 
   } else if (output->state.tick < tick && (tick - output->state.tick) > ARTNET_SEQ_TICKS) {
     LOG_WARN("resync address=%04x seq=%d < %d on timeout", output->options.address, dmx->seq, output->state.seq);
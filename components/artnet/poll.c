@@ -0,0 +1,242 @@
+#include "artnet.h"
+
+#include <logging.h>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lwip/sockets.h>
+
+static const uint8_t artnet_id[8] = ARTNET_ID;
+
+int artnet_poll_init(struct artnet *artnet)
+{
+  unsigned size = artnet->input_size + artnet->output_size;
+
+  // one reply per bind_index, worst case one per port
+  if (size > ARTNET_POLL_REPLY_BIND_INDEX_MAX) {
+    size = ARTNET_POLL_REPLY_BIND_INDEX_MAX;
+  }
+
+  if (!(artnet->poll_mutex = xSemaphoreCreateMutex())) {
+    LOG_ERROR("xSemaphoreCreateMutex");
+    return -1;
+  }
+
+  if (!(artnet->poll_queue = xQueueCreate(ARTNET_POLL_QUEUE_SIZE, sizeof(struct artnet_poll_request)))) {
+    LOG_ERROR("xQueueCreate");
+    return -1;
+  }
+
+  if (size && !(artnet->poll_replies = calloc(size, sizeof(*artnet->poll_replies)))) {
+    LOG_ERROR("calloc(poll_replies)");
+    return -1;
+  }
+
+  artnet->poll_reply_size = size;
+  artnet->poll_reply_count = 0;
+  artnet->poll_valid = false;
+
+  return 0;
+}
+
+void artnet_poll_invalidate(struct artnet *artnet)
+{
+  if (!artnet->poll_mutex) {
+    return;
+  }
+
+  xSemaphoreTake(artnet->poll_mutex, portMAX_DELAY);
+
+  artnet->poll_valid = false;
+
+  xSemaphoreGive(artnet->poll_mutex);
+}
+
+void artnet_poll_set_metadata(struct artnet *artnet, const struct artnet_metadata *metadata)
+{
+  xSemaphoreTake(artnet->poll_mutex, portMAX_DELAY);
+
+  artnet->options.metadata = *metadata;
+  artnet->poll_valid = false;
+
+  xSemaphoreGive(artnet->poll_mutex);
+}
+
+static void artnet_poll_build_header(struct artnet *artnet, struct artnet_packet_poll_reply *reply)
+{
+  memset(reply, 0, sizeof(*reply));
+  memcpy(reply->id, artnet_id, sizeof(reply->id));
+  reply->opcode = ARTNET_OP_POLL_REPLY;
+
+  memcpy(reply->ip_address, artnet->options.metadata.ip_address, sizeof(reply->ip_address));
+  memcpy(&reply->bind_ip, artnet->options.metadata.ip_address, sizeof(reply->bind_ip));
+
+  reply->port_number = artnet_pack_u16lh(artnet->options.port);
+
+  strncpy((char *) reply->short_name, artnet->options.metadata.short_name, sizeof(reply->short_name));
+  strncpy((char *) reply->long_name, artnet->options.metadata.long_name, sizeof(reply->long_name));
+
+  memcpy(reply->mac, artnet->options.metadata.mac_address, 6);
+
+  reply->status2 = ARTNET_STATUS2_ARTNET3_SUPPORT | ARTNET_STATUS2_DHCP_SUPPORT;
+}
+
+/* Rebuild cached ArtPollReply packets, grouping input/output ports by net/subnet. Called with poll_mutex held */
+static void artnet_poll_build(struct artnet *artnet)
+{
+  unsigned bind_index = 0;
+  struct artnet_input *input_port = artnet->input_ports;
+  struct artnet_output *output_port = artnet->output_ports;
+
+  while (input_port < artnet->input_ports + artnet->input_count || output_port < artnet->output_ports + artnet->output_count) {
+    struct artnet_poll_reply *poll_reply;
+    struct artnet_packet_poll_reply *reply;
+    uint16_t ports_address = 0;
+    uint16_t input_ports = 0, output_ports = 0;
+
+    if (bind_index >= artnet->poll_reply_size) {
+      LOG_WARN("bind_index=%u overflow", bind_index);
+      break;
+    }
+
+    poll_reply = &artnet->poll_replies[bind_index];
+    reply = &poll_reply->packet;
+
+    artnet_poll_build_header(artnet, reply);
+
+    if (output_port < artnet->output_ports + artnet->output_count) {
+      ports_address = (output_port->options.address & 0x7FF0);
+    }
+    if (input_port < artnet->input_ports + artnet->input_count) {
+      ports_address = (input_port->options.address & 0x7FF0);
+    }
+
+    while (input_port < artnet->input_ports + artnet->input_count) {
+      if ((input_port->options.address & 0x7FF0) != ports_address) {
+        break;
+      }
+
+      if (input_ports >= 4) {
+        break;
+      }
+
+      reply->port_types[input_ports] |= ARTNET_PORT_TYPE_INPUT;
+      reply->good_input[input_ports] = 0;
+      reply->sw_in[input_ports] = (input_port->options.address & 0x000F);
+
+      poll_reply->inputs[input_ports] = input_port;
+
+      input_ports++;
+      input_port++;
+    }
+
+    while (output_port < artnet->output_ports + artnet->output_count) {
+      if ((output_port->options.address & 0x7FF0) != ports_address) {
+        break;
+      }
+
+      if (output_ports >= 4) {
+        break;
+      }
+
+      reply->port_types[output_ports] |= ARTNET_PORT_TYPE_OUTPUT;
+      reply->good_output[output_ports] = ARTNET_OUTPUT_TRANSMITTING;
+      reply->sw_out[output_ports] = (output_port->options.address & 0x000F);
+
+      output_ports++;
+      output_port++;
+    }
+
+    reply->net_switch = (ports_address & 0x7F00) >> 8;
+    reply->sub_switch = (ports_address & 0x00F0) >> 4;
+    reply->num_ports = artnet_pack_u16hl(output_ports > input_ports ? output_ports : input_ports);
+    reply->bind_index = bind_index;
+
+    poll_reply->input_count = input_ports;
+
+    bind_index++;
+  }
+
+  artnet->poll_reply_count = bind_index;
+  artnet->poll_valid = true;
+
+  stats_counter_increment(&artnet->stats.poll_build);
+}
+
+/* Patch live status fields into cached packet */
+static void artnet_poll_update(struct artnet_poll_reply *poll_reply, TickType_t tick)
+{
+  for (unsigned i = 0; i < poll_reply->input_count; i++) {
+    TickType_t input_tick = poll_reply->inputs[i]->state.tick;
+
+    if (input_tick && tick - input_tick < ARTNET_POLL_INPUT_TICKS) {
+      poll_reply->packet.good_input[i] = ARTNET_INPUT_DATA_RECEIVED;
+    } else {
+      poll_reply->packet.good_input[i] = 0;
+    }
+  }
+}
+
+static int artnet_poll_reply(struct artnet *artnet, const struct artnet_poll_request *request)
+{
+  TickType_t tick = xTaskGetTickCount();
+  int err = 0;
+
+  xSemaphoreTake(artnet->poll_mutex, portMAX_DELAY);
+
+  if (!artnet->poll_valid) {
+    artnet_poll_build(artnet);
+  }
+
+  for (unsigned i = 0; i < artnet->poll_reply_count; i++) {
+    struct artnet_poll_reply *poll_reply = &artnet->poll_replies[i];
+
+    artnet_poll_update(poll_reply, tick);
+
+    if (sendto(artnet->socket, &poll_reply->packet, sizeof(poll_reply->packet), 0, &request->addr, request->addrlen) < 0) {
+      LOG_WARN("sendto: %s", strerror(errno));
+      stats_counter_increment_shared(&artnet->stats.send_error);
+      err = -1;
+      break;
+    }
+
+    stats_counter_increment(&artnet->stats.send_poll_reply);
+  }
+
+  xSemaphoreGive(artnet->poll_mutex);
+
+  return err;
+}
+
+int artnet_poll_request(struct artnet *artnet, const struct artnet_sendrecv *recv)
+{
+  struct artnet_poll_request request = {
+    .addr     = recv->addr,
+    .addrlen  = recv->addrlen,
+  };
+
+  if (xQueueSend(artnet->poll_queue, &request, 0) == errQUEUE_FULL) {
+    LOG_DEBUG("poll queue full");
+    stats_counter_increment(&artnet->stats.poll_drop);
+  }
+
+  return 0;
+}
+
+int artnet_poll_main(struct artnet *artnet)
+{
+  struct artnet_poll_request request;
+
+  for (;;) {
+    if (!xQueueReceive(artnet->poll_queue, &request, portMAX_DELAY)) {
+      continue;
+    }
+
+    WITH_STATS_TIMER(&artnet->stats.poll) {
+      if (artnet_poll_reply(artnet, &request)) {
+        LOG_WARN("artnet_poll_reply");
+      }
+    }
+  }
+}
@@ -0,0 +1,177 @@
+#include "artnet.h"
+
+#include <logging.h>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lwip/sockets.h>
+
+static const uint8_t artnet_id[8] = ARTNET_ID;
+
+static void artnet_transmit_header(struct artnet_packet_header *header, enum artnet_opcode opcode)
+{
+  memcpy(header->id, artnet_id, sizeof(header->id));
+
+  header->opcode = artnet_pack_u16lh(opcode);
+  header->version = artnet_pack_u16hl(ARTNET_VERSION);
+}
+
+int artnet_transmit_init(struct artnet *artnet)
+{
+  const struct artnet_transmit_options *options = &artnet->options.transmit;
+  int broadcast = 1;
+
+  if (!options->enabled) {
+    return 0;
+  }
+
+  if (options->address_count > ARTNET_TRANSMIT_ADDRESSES_MAX) {
+    LOG_ERROR("address_count=%u exceeds max=%u", options->address_count, ARTNET_TRANSMIT_ADDRESSES_MAX);
+    return -1;
+  }
+
+  // allow sending to broadcast addresses
+  if (setsockopt(artnet->socket, SOL_SOCKET, SO_BROADCAST, &broadcast, sizeof(broadcast)) < 0) {
+    LOG_ERROR("setsockopt(SO_BROADCAST): %s", strerror(errno));
+    return -1;
+  }
+
+  for (unsigned i = 0; i < options->address_count; i++) {
+    struct sockaddr_in *addr = &artnet->transmit_addrs[i];
+
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(artnet->options.port);
+    memcpy(&addr->sin_addr.s_addr, options->addresses[i], sizeof(addr->sin_addr.s_addr));
+
+    LOG_INFO("transmit address=%u.%u.%u.%u", options->addresses[i][0], options->addresses[i][1], options->addresses[i][2], options->addresses[i][3]);
+  }
+
+  if (options->address_count) {
+    artnet->transmit_addr_count = options->address_count;
+  } else {
+    struct sockaddr_in *addr = &artnet->transmit_addrs[0];
+
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(artnet->options.port);
+    addr->sin_addr.s_addr = htonl(INADDR_BROADCAST);
+
+    LOG_INFO("transmit broadcast");
+
+    artnet->transmit_addr_count = 1;
+  }
+
+  // prepare constant packet
+  artnet_transmit_header(&artnet->transmit_sync.header, ARTNET_OP_SYNC);
+
+  return 0;
+}
+
+int artnet_transmit_init_input(struct artnet *artnet, struct artnet_input *input)
+{
+  struct artnet_packet_dmx *dmx;
+
+  if (!artnet->options.transmit.enabled) {
+    return 0;
+  }
+
+  if (!(input->transmit_packet = calloc(1, sizeof(*input->transmit_packet)))) {
+    LOG_ERROR("calloc");
+    return -1;
+  }
+
+  dmx = &input->transmit_packet->dmx;
+
+  // prepare header fields, only seq/len/data change per packet
+  artnet_transmit_header(&dmx->header, ARTNET_OP_DMX);
+
+  dmx->sequence = 0;
+  dmx->physical = input->index;
+  dmx->sub_uni = (input->options.address & 0x00FF);
+  dmx->net = (input->options.address & 0x7F00) >> 8;
+
+  return 0;
+}
+
+static int artnet_transmit(struct artnet *artnet, const void *packet, size_t len)
+{
+  int err = 0;
+
+  for (unsigned i = 0; i < artnet->transmit_addr_count; i++) {
+    const struct sockaddr_in *addr = &artnet->transmit_addrs[i];
+
+    if (sendto(artnet->socket, packet, len, 0, (const struct sockaddr *) addr, sizeof(*addr)) < 0) {
+      LOG_WARN("sendto %08x: %s", ntohl(addr->sin_addr.s_addr), strerror(errno));
+      stats_counter_increment_shared(&artnet->stats.send_error);
+      err = -1;
+    }
+  }
+
+  return err;
+}
+
+/* Unchanged universes are only re-sent at the keepalive interval */
+static bool artnet_transmit_skip(struct artnet *artnet, struct artnet_input *input, const struct artnet_dmx *dmx, uint16_t len, TickType_t tick)
+{
+  const struct artnet_packet_dmx *packet = &input->transmit_packet->dmx;
+  TickType_t keepalive_ticks = artnet->options.transmit.keepalive_ticks;
+
+  if (!keepalive_ticks || !input->transmit_tick) {
+    return false;
+  }
+
+  if (tick - input->transmit_tick >= keepalive_ticks) {
+    return false;
+  }
+
+  return artnet_unpack_u16hl(packet->length) == len && memcmp(packet->data, dmx->data, len) == 0;
+}
+
+int artnet_transmit_dmx(struct artnet *artnet, struct artnet_input *input, const struct artnet_dmx *dmx)
+{
+  struct artnet_packet_dmx *packet;
+  TickType_t tick = xTaskGetTickCount();
+  uint16_t len = dmx->len;
+
+  if (!input->transmit_packet) {
+    return 1;
+  }
+
+  packet = &input->transmit_packet->dmx;
+
+  // even length 2..512
+  if (len < 2) {
+    len = 2;
+  } else if (len > ARTNET_DMX_SIZE) {
+    len = ARTNET_DMX_SIZE;
+  } else if (len % 2) {
+    len++;
+  }
+
+  if (artnet_transmit_skip(artnet, input, dmx, len, tick)) {
+    stats_counter_increment(&input->stats.dmx_skip);
+
+    return 1;
+  }
+
+  // seq 0 is reserved for disabled sequencing
+  if (++packet->sequence == 0) {
+    packet->sequence = 1;
+  }
+
+  packet->length = artnet_pack_u16hl(len);
+  memcpy(packet->data, dmx->data, len);
+
+  input->transmit_tick = tick;
+
+  stats_counter_increment(&input->stats.dmx_send);
+
+  return artnet_transmit(artnet, packet, sizeof(*packet) + len);
+}
+
+int artnet_transmit_sync(struct artnet *artnet)
+{
+  stats_counter_increment(&artnet->stats.send_sync);
+
+  return artnet_transmit(artnet, &artnet->transmit_sync, sizeof(artnet->transmit_sync));
+}
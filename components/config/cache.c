@@ -0,0 +1,556 @@
+#include <config.h>
+#include "state.h"
+
+#include <logging.h>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define CONFIG_CACHE_MAGIC 0x47464351 // "QCFG"
+#define CONFIG_CACHE_VERSION 2
+
+#define FNV_OFFSET 0x811c9dc5
+#define FNV_PRIME 0x01000193
+
+/*
+ * The cache file is a header followed by the raw configtab values, in configmod/configtab order.
+ *
+ * Multi-valued configtabs are stored as a uint32_t count followed by all size values.
+ */
+struct config_cache_header {
+  uint32_t magic;
+  uint32_t version;
+
+  /* Hash of configmod/configtab names, types, sizes, limits, defaults and enum values */
+  uint32_t schema_hash;
+
+  /* Source .ini file */
+  uint32_t file_size;
+  uint32_t file_mtime;
+
+  uint32_t data_size;
+  uint32_t data_hash;
+};
+
+struct config_cache_data {
+  uint8_t *ptr, *end;
+  uint32_t hash;
+};
+
+typedef int (config_cache_func_t)(const struct config_path path, void *ctx);
+
+static uint32_t fnv_hash(uint32_t hash, const void *buf, size_t len)
+{
+  const uint8_t *ptr = buf;
+
+  for (size_t i = 0; i < len; i++) {
+    hash ^= ptr[i];
+    hash *= FNV_PRIME;
+  }
+
+  return hash;
+}
+
+static uint32_t fnv_hash_str(uint32_t hash, const char *str)
+{
+  // include NUL terminator to separate names
+  return fnv_hash(hash, str, strlen(str) + 1);
+}
+
+static unsigned configtab_slots(const struct configtab *tab)
+{
+  if (tab->count) {
+    return tab->size;
+  } else {
+    return 1;
+  }
+}
+
+/* Return pointer to and size of all values, or NULL if not supported */
+static void *configtab_values(const struct configtab *tab, size_t *sizep)
+{
+  unsigned slots = configtab_slots(tab);
+
+  switch (tab->type) {
+    case CONFIG_TYPE_UINT16:
+      *sizep = slots * sizeof(*tab->uint16_type.value);
+      return tab->uint16_type.value;
+
+    case CONFIG_TYPE_STRING:
+      *sizep = slots * tab->string_type.size;
+      return tab->string_type.value;
+
+    case CONFIG_TYPE_BOOL:
+      *sizep = slots * sizeof(*tab->bool_type.value);
+      return tab->bool_type.value;
+
+    case CONFIG_TYPE_ENUM:
+      *sizep = slots * sizeof(*tab->enum_type.value);
+      return tab->enum_type.value;
+
+    case CONFIG_TYPE_FILE:
+      *sizep = slots * tab->file_type.size;
+      return tab->file_type.value;
+
+    case CONFIG_TYPE_COLOR:
+      *sizep = slots * sizeof(*tab->color_type.value);
+      return tab->color_type.value;
+
+    default:
+      *sizep = 0;
+      return NULL;
+  }
+}
+
+/* Call func for each non-migrated configtab, in config_write() order */
+static int config_cache_walk(const struct config *config, config_cache_func_t *func, void *ctx)
+{
+  int err;
+
+  for (const struct configmod *mod = config->modules; mod->name; mod++) {
+    unsigned tables_count = mod->tables_count ? mod->tables_count : 1;
+
+    for (unsigned i = 0; i < tables_count; i++) {
+      const struct configtab *table = mod->tables_count ? mod->tables[i] : mod->table;
+      unsigned index = mod->tables_count ? i + 1 : 0;
+
+      for (const struct configtab *tab = table; tab->name; tab++) {
+        struct config_path path = { mod, index, tab };
+
+        if (tab->migrated) {
+          continue;
+        }
+
+        if ((err = func(path, ctx))) {
+          return err;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+/* Cached values also include defaults for keys missing from the .ini file, and enum values by number */
+static uint32_t config_cache_schema_values(uint32_t hash, const struct configtab *tab)
+{
+  switch (tab->type) {
+    case CONFIG_TYPE_UINT16:
+      hash = fnv_hash(hash, &tab->uint16_type.max, sizeof(tab->uint16_type.max));
+      hash = fnv_hash(hash, &tab->uint16_type.default_value, sizeof(tab->uint16_type.default_value));
+      break;
+
+    case CONFIG_TYPE_STRING:
+      hash = fnv_hash_str(hash, tab->string_type.default_value ? tab->string_type.default_value : "");
+      break;
+
+    case CONFIG_TYPE_BOOL:
+      hash = fnv_hash(hash, &tab->bool_type.default_value, sizeof(tab->bool_type.default_value));
+      break;
+
+    case CONFIG_TYPE_ENUM:
+      hash = fnv_hash(hash, &tab->enum_type.default_value, sizeof(tab->enum_type.default_value));
+
+      for (const struct config_enum *e = tab->enum_type.values; e && e->name; e++) {
+        hash = fnv_hash_str(hash, e->name);
+        hash = fnv_hash(hash, &e->value, sizeof(e->value));
+      }
+      break;
+
+    case CONFIG_TYPE_COLOR:
+      hash = fnv_hash(hash, &tab->color_type.default_value, sizeof(tab->color_type.default_value));
+      break;
+
+    default:
+      break;
+  }
+
+  return hash;
+}
+
+static int config_cache_schema_func(const struct config_path path, void *ctx)
+{
+  const struct configtab *tab = path.tab;
+  uint32_t *hashp = ctx;
+  uint32_t values[3] = { path.index, tab->type, configtab_slots(tab) };
+  size_t size;
+
+  if (!configtab_values(tab, &size)) {
+    LOG_ERROR("%s%u.%s: unsupported type=%d", path.mod->name, path.index, tab->name, tab->type);
+    return -1;
+  }
+
+  *hashp = fnv_hash_str(*hashp, path.mod->name);
+  *hashp = fnv_hash_str(*hashp, tab->name);
+  *hashp = fnv_hash(*hashp, values, sizeof(values));
+  *hashp = fnv_hash(*hashp, &size, sizeof(size));
+  *hashp = config_cache_schema_values(*hashp, tab);
+
+  return 0;
+}
+
+static int config_cache_size_func(const struct config_path path, void *ctx)
+{
+  const struct configtab *tab = path.tab;
+  size_t *sizep = ctx;
+  size_t size;
+
+  configtab_values(tab, &size);
+
+  if (tab->count) {
+    *sizep += sizeof(uint32_t);
+  }
+
+  *sizep += size;
+
+  return 0;
+}
+
+static int config_cache_write_func(const struct config_path path, void *ctx)
+{
+  const struct configtab *tab = path.tab;
+  struct config_cache_data *data = ctx;
+  size_t size;
+  const void *values = configtab_values(tab, &size);
+
+  if (tab->count) {
+    uint32_t count = *tab->count;
+
+    memcpy(data->ptr, &count, sizeof(count));
+    data->ptr += sizeof(count);
+  }
+
+  memcpy(data->ptr, values, size);
+  data->ptr += size;
+
+  return 0;
+}
+
+static int config_cache_check_func(const struct config_path path, void *ctx)
+{
+  const struct configtab *tab = path.tab;
+  struct config_cache_data *data = ctx;
+  size_t size;
+
+  configtab_values(tab, &size);
+
+  if (tab->count) {
+    uint32_t count;
+
+    memcpy(&count, data->ptr, sizeof(count));
+    data->ptr += sizeof(count);
+
+    if (count > tab->size) {
+      LOG_WARN("%s%u.%s: invalid count=%u for size=%u", path.mod->name, path.index, tab->name, count, tab->size);
+      return 1;
+    }
+  }
+
+  data->ptr += size;
+
+  if (data->ptr > data->end) {
+    LOG_WARN("%s%u.%s: overflow", path.mod->name, path.index, tab->name);
+    return 1;
+  }
+
+  return 0;
+}
+
+static int config_cache_read_func(const struct config_path path, void *ctx)
+{
+  const struct configtab *tab = path.tab;
+  struct config_cache_data *data = ctx;
+  size_t size;
+  void *values = configtab_values(tab, &size);
+
+  if (tab->count) {
+    uint32_t count;
+
+    memcpy(&count, data->ptr, sizeof(count));
+    data->ptr += sizeof(count);
+
+    *tab->count = count;
+  }
+
+  memcpy(values, data->ptr, size);
+  data->ptr += size;
+
+  return 0;
+}
+
+static int config_cache_schema(const struct config *config, uint32_t *hashp, size_t *sizep)
+{
+  uint32_t version = CONFIG_CACHE_VERSION;
+  int err;
+
+  *hashp = fnv_hash(FNV_OFFSET, &version, sizeof(version));
+  *sizep = 0;
+
+  if ((err = config_cache_walk(config, config_cache_schema_func, hashp))) {
+    return err;
+  }
+
+  if ((err = config_cache_walk(config, config_cache_size_func, sizep))) {
+    return err;
+  }
+
+  return 0;
+}
+
+static int config_cache_paths(const struct config *config, const char *filename, char *file_path, char *cache_path, size_t size)
+{
+  const char *suffix = strrchr(filename, '.');
+
+  if (!suffix || strcmp(suffix + 1, CONFIG_FILE_EXT)) {
+    LOG_ERROR("filename must end with .%s: %s", CONFIG_FILE_EXT, filename);
+    return -1;
+  }
+
+  if (snprintf(file_path, size, "%s/%s", config->path, filename) >= size) {
+    LOG_ERROR("filename too long: %s", filename);
+    return -1;
+  }
+
+  if (snprintf(cache_path, size, "%s/%.*s.%s", config->path, (int) (suffix - filename), filename, CONFIG_CACHE_EXT) >= size) {
+    LOG_ERROR("filename too long: %s", filename);
+    return -1;
+  }
+
+  return 0;
+}
+
+/* Returns 0 if found, >0 if not found, <0 on error */
+static int config_cache_stat(const char *path, uint32_t *sizep, uint32_t *mtimep)
+{
+  struct stat st;
+
+  if (stat(path, &st)) {
+    if (errno == ENOENT) {
+      return 1;
+    } else {
+      LOG_ERROR("stat %s: %s", path, strerror(errno));
+      return -1;
+    }
+  }
+
+  *sizep = st.st_size;
+  *mtimep = st.st_mtime;
+
+  return 0;
+}
+
+int config_load_cache(struct config *config, const char *filename)
+{
+  char file_path[CONFIG_PATH_SIZE], cache_path[CONFIG_PATH_SIZE];
+  struct config_cache_header expect = { .magic = CONFIG_CACHE_MAGIC, .version = CONFIG_CACHE_VERSION };
+  struct config_cache_header *header;
+  struct config_cache_data data;
+  size_t data_size, read_size;
+  uint8_t *buf = NULL;
+  FILE *file = NULL;
+  int err;
+
+  if ((err = config_cache_paths(config, filename, file_path, cache_path, sizeof(file_path)))) {
+    return err;
+  }
+
+  if ((err = config_cache_stat(file_path, &expect.file_size, &expect.file_mtime))) {
+    // no config file, or error
+    return err;
+  }
+
+  if ((err = config_cache_schema(config, &expect.schema_hash, &data_size))) {
+    return err;
+  }
+
+  expect.data_size = data_size;
+  read_size = sizeof(*header) + data_size;
+
+  if (!(file = fopen(cache_path, "r"))) {
+    if (errno == ENOENT) {
+      LOG_INFO("%s: not found", cache_path);
+      return 1;
+    } else {
+      LOG_ERROR("fopen %s: %s", cache_path, strerror(errno));
+      return -1;
+    }
+  }
+
+  if (!(buf = malloc(read_size))) {
+    LOG_ERROR("malloc(%u)", read_size);
+    err = -1;
+    goto error;
+  }
+
+  // single read for both header and data
+  if (fread(buf, 1, read_size, file) != read_size) {
+    LOG_WARN("%s: short read", cache_path);
+    err = 1;
+    goto error;
+  }
+
+  header = (struct config_cache_header *) buf;
+
+  data.ptr = buf + sizeof(*header);
+  data.end = buf + read_size;
+  data.hash = fnv_hash(FNV_OFFSET, data.ptr, data_size);
+
+  if (header->magic != expect.magic || header->version != expect.version) {
+    LOG_WARN("%s: invalid magic=%08x version=%u", cache_path, header->magic, header->version);
+    err = 1;
+  } else if (header->schema_hash != expect.schema_hash || header->data_size != expect.data_size) {
+    LOG_WARN("%s: stale schema", cache_path);
+    err = 1;
+  } else if (header->file_size != expect.file_size || header->file_mtime != expect.file_mtime) {
+    LOG_WARN("%s: stale file %s", cache_path, file_path);
+    err = 1;
+  } else if (header->data_hash != data.hash) {
+    LOG_WARN("%s: invalid data hash", cache_path);
+    err = 1;
+  }
+
+  if (err) {
+    goto error;
+  }
+
+  // verify before modifying any config values
+  if ((err = config_cache_walk(config, config_cache_check_func, &data))) {
+    goto error;
+  }
+
+  data.ptr = buf + sizeof(*header);
+
+  if (snprintf(config->filename, sizeof(config->filename), "%s", filename) >= sizeof(config->filename)) {
+    LOG_ERROR("filename too long: %s", filename);
+    err = -1;
+    goto error;
+  }
+
+  if ((err = config_cache_walk(config, config_cache_read_func, &data))) {
+    goto error;
+  }
+
+  LOG_INFO("%s: loaded %u bytes", cache_path, data_size);
+
+  config->cached = true;
+  config_state(config, CONFIG_STATE_LOAD);
+
+error:
+  if (buf) {
+    free(buf);
+  }
+
+  fclose(file);
+
+  return err;
+}
+
+int config_save_cache(struct config *config, const char *filename)
+{
+  char file_path[CONFIG_PATH_SIZE], cache_path[CONFIG_PATH_SIZE];
+  char newfile[CONFIG_PATH_SIZE];
+  struct config_cache_header header = { .magic = CONFIG_CACHE_MAGIC, .version = CONFIG_CACHE_VERSION };
+  struct config_cache_data data;
+  size_t data_size, write_size;
+  uint8_t *buf;
+  FILE *file;
+  int err;
+
+  if ((err = config_cache_paths(config, filename, file_path, cache_path, sizeof(file_path)))) {
+    return err;
+  }
+
+  if (snprintf(newfile, sizeof(newfile), "%s.new", cache_path) >= sizeof(newfile)) {
+    LOG_ERROR("filename too long: %s.new", cache_path);
+    return -1;
+  }
+
+  if ((err = config_cache_stat(file_path, &header.file_size, &header.file_mtime))) {
+    LOG_WARN("config_cache_stat %s", file_path);
+    return err;
+  }
+
+  if ((err = config_cache_schema(config, &header.schema_hash, &data_size))) {
+    return err;
+  }
+
+  write_size = sizeof(header) + data_size;
+
+  if (!(buf = malloc(write_size))) {
+    LOG_ERROR("malloc(%u)", write_size);
+    return -1;
+  }
+
+  data.ptr = buf + sizeof(header);
+  data.end = buf + write_size;
+
+  if ((err = config_cache_walk(config, config_cache_write_func, &data))) {
+    goto error;
+  }
+
+  header.data_size = data_size;
+  header.data_hash = fnv_hash(FNV_OFFSET, buf + sizeof(header), data_size);
+
+  memcpy(buf, &header, sizeof(header));
+
+  if ((file = fopen(newfile, "w")) == NULL) {
+    LOG_ERROR("fopen %s: %s", newfile, strerror(errno));
+    err = -1;
+    goto error;
+  }
+
+  if (fwrite(buf, 1, write_size, file) != write_size) {
+    LOG_ERROR("fwrite %s: %s", newfile, strerror(errno));
+    fclose(file);
+    err = -1;
+    goto error;
+  }
+
+  if (fclose(file)) {
+    LOG_ERROR("fclose %s: %s", newfile, strerror(errno));
+    err = -1;
+    goto error;
+  }
+
+  if (remove(cache_path) && errno != ENOENT) {
+    LOG_ERROR("remove %s: %s", cache_path, strerror(errno));
+    err = -1;
+    goto error;
+  }
+
+  if (rename(newfile, cache_path)) {
+    LOG_ERROR("rename %s -> %s: %s", newfile, cache_path, strerror(errno));
+    err = -1;
+    goto error;
+  }
+
+  LOG_INFO("%s: saved %u bytes", cache_path, data_size);
+
+error:
+  free(buf);
+
+  return err;
+}
+
+int config_delete_cache(struct config *config, const char *filename)
+{
+  char file_path[CONFIG_PATH_SIZE], cache_path[CONFIG_PATH_SIZE];
+  int err;
+
+  if ((err = config_cache_paths(config, filename, file_path, cache_path, sizeof(file_path)))) {
+    return err;
+  }
+
+  if (remove(cache_path) == 0) {
+    LOG_INFO("remove %s", cache_path);
+    return 0;
+  } else if (errno == ENOENT) {
+    LOG_DEBUG("remove %s: %s", cache_path, strerror(errno));
+    return 1;
+  } else {
+    LOG_ERROR("remove %s: %s", cache_path, strerror(errno));
+    return -1;
+  }
+}
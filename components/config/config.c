@@ -115,6 +115,8 @@ int config_load(struct config *config, const char *filename)
     goto file_error;
   }
 
+  config->cached = false;
+
   if ((err = config_read(config, file))) {
     goto file_error;
   }
@@ -153,6 +155,12 @@ int config_save(struct config *config, const char *filename)
     return err;
   }
 
+  // cache is regenerated on next boot
+  if (config_delete_cache(config, filename) < 0) {
+    LOG_ERROR("config_delete_cache");
+    return -1;
+  }
+
   if (snprintf(newfile, sizeof(newfile), "%s.new", path) >= sizeof(newfile)) {
     LOG_ERROR("filename too long: %s.new", filename);
     return -1;
@@ -205,6 +213,11 @@ int config_delete(struct config *config, const char *filename)
     return err;
   }
 
+  if (config_delete_cache(config, filename) < 0) {
+    LOG_ERROR("config_delete_cache");
+    return -1;
+  }
+
   if (remove(path) == 0) {
     LOG_INFO("remove %s", path);
     return 0;
@@ -8,6 +8,7 @@
 #include <freertos/FreeRTOS.h>
 
 #define CONFIG_FILE_EXT "ini"
+#define CONFIG_CACHE_EXT "bin"
 #define CONFIG_BOOT_FILE "boot.ini"
 
 #define CONFIG_PATH_SIZE 64
@@ -154,6 +155,9 @@ struct config {
   char filename[CONFIG_PATH_SIZE];
   enum config_state state;
   TickType_t tick;
+
+  /* Loaded from binary cache */
+  bool cached;
 };
 
 int config_enum_lookup(const struct config_enum *e, const char *name, const struct config_enum **enump);
@@ -249,6 +253,28 @@ int config_walk(struct config *config, int (func)(const char *filename, void *ct
  */
 int config_load(struct config *config, const char *filename);
 
+/*
+ * Load config from the binary cache of the given .ini file, skipping the parsing of the file.
+ *
+ * The cache is only used if it matches the configtab schema, including default and enum values, and the size/mtime of
+ * the .ini file. Anything else that writes the .ini file, bypassing `config_save()`, must use `config_delete_cache()`.
+ *
+ * Returns 0 if loaded, >0 if the cache is missing or stale, <0 on error.
+ */
+int config_load_cache(struct config *config, const char *filename);
+
+/*
+ * Save the loaded config as the binary cache of the given .ini file.
+ */
+int config_save_cache(struct config *config, const char *filename);
+
+/*
+ * Remove the binary cache of the given .ini file.
+ *
+ * Returns <0 on error, 0 if removed, >0 if no cache to remove.
+ */
+int config_delete_cache(struct config *config, const char *filename);
+
 /*
  * Mark config as booted.
  */
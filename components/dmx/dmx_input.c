@@ -7,6 +7,10 @@
 #include <errno.h>
 #include <stdlib.h>
 
+#if DMX_INPUT_ISR_SUPPORTED
+  #include <esp_attr.h>
+#endif
+
 static void dmx_input_stats_init(struct dmx_input_stats *stats)
 {
   stats_timer_init(&stats->uart_open);
@@ -20,6 +24,10 @@ static void dmx_input_stats_init(struct dmx_input_stats *stats)
   stats_counter_init(&stats->cmd_unknown);
 
   stats_gauge_init(&stats->data_len);
+
+  stats_counter_init(&stats->frame_drop);
+  stats_gauge_init(&stats->frame_rate);
+  stats_gauge_init(&stats->frame_slots);
 }
 
 int dmx_input_init (struct dmx_input *in, struct dmx_input_options options)
@@ -33,6 +41,13 @@ int dmx_input_init (struct dmx_input *in, struct dmx_input_options options)
 
   dmx_input_stats_init(&in->stats);
 
+#if DMX_INPUT_ISR_SUPPORTED
+  portMUX_INITIALIZE(&in->isr_mux);
+
+  in->isr_frames[0] = options.data;
+  in->isr_frames[1] = options.data_alt;
+#endif
+
   return 0;
 }
 
@@ -75,11 +90,177 @@ void dmx_input_stats(struct dmx_input *in, struct dmx_input_stats *stats, bool r
 
   stats->data_len = stats_gauge_copy(&in->stats.data_len);
 
+  stats->frame_drop = stats_counter_copy(&in->stats.frame_drop);
+  stats->frame_rate = stats_gauge_copy(&in->stats.frame_rate);
+  stats->frame_slots = stats_gauge_copy(&in->stats.frame_slots);
+
   if (reset) {
     dmx_input_stats_init(&in->stats);
   }
 }
 
+#if DMX_INPUT_ISR_SUPPORTED
+/* Consume len bytes from the RX FIFO */
+static void IRAM_ATTR dmx_input_isr_process (struct dmx_input *in, size_t len)
+{
+  uint8_t *data = in->isr_frames[in->isr_back];
+  unsigned offset = in->options.address ? in->options.address - 1 : 0;
+
+  while (len) {
+    unsigned count = len;
+    uint8_t cmd;
+
+    switch(in->state) {
+      case DMX_INPUT_STATE_BREAK:
+      case DMX_INPUT_STATE_NOOP:
+        /* Ignore, waiting for break to sync start of packet */
+        uart_isr_rx_skip(in->uart, count);
+
+        break;
+
+      case DMX_INPUT_STATE_CMD:
+        count = 1;
+        uart_isr_rx_read(in->uart, &cmd, count);
+
+        in->state_cmd = cmd;
+        in->state_len = 0;
+        in->state_data_index = 0;
+
+        if (cmd == DMX_CMD_DIMMER) {
+          stats_counter_increment(&in->stats.cmd_dimmer);
+
+          in->state = DMX_INPUT_STATE_DATA;
+        } else {
+          stats_counter_increment(&in->stats.cmd_unknown);
+
+          in->state = DMX_INPUT_STATE_NOOP;
+        }
+
+        break;
+
+      case DMX_INPUT_STATE_DATA:
+        if (in->state_data_index < offset) {
+          // skip slots before address
+          if (count > offset - in->state_data_index) {
+            count = offset - in->state_data_index;
+          }
+
+          uart_isr_rx_skip(in->uart, count);
+
+        } else if (in->state_data_index - offset < in->options.size) {
+          // read slots directly into frame
+          unsigned index = in->state_data_index - offset;
+
+          if (count > in->options.size - index) {
+            count = in->options.size - index;
+          }
+
+          uart_isr_rx_read(in->uart, data + index, count);
+
+          in->state_len += count;
+
+        } else {
+          // skip slots after size
+          uart_isr_rx_skip(in->uart, count);
+        }
+
+        in->state_data_index += count;
+
+        break;
+    }
+
+    len -= count;
+  }
+}
+
+/* Complete any frame in progress, and notify task */
+static void IRAM_ATTR dmx_input_isr_frame (struct dmx_input *in, BaseType_t *task_woken)
+{
+  bool notify = false;
+
+  if (in->state != DMX_INPUT_STATE_DATA || !in->state_len) {
+    return;
+  }
+
+  taskENTER_CRITICAL_ISR(&in->isr_mux);
+
+  if (in->isr_busy) {
+    // task is still reading the previous frame, overwrite this one
+    stats_counter_increment(&in->stats.frame_drop);
+  } else {
+    if (in->isr_ready) {
+      // previous frame was never read
+      stats_counter_increment(&in->stats.frame_drop);
+    }
+
+    in->isr_frame = (struct dmx_input_frame) {
+      .data   = in->isr_frames[in->isr_back],
+      .len    = in->state_len,
+      .slots  = in->state_data_index,
+      .time   = esp_timer_get_time(),
+    };
+
+    in->isr_back = !in->isr_back;
+    in->isr_ready = true;
+
+    notify = true;
+  }
+
+  taskEXIT_CRITICAL_ISR(&in->isr_mux);
+
+  if (notify && in->isr_task) {
+    vTaskNotifyGiveFromISR(in->isr_task, task_woken);
+  }
+}
+
+static void IRAM_ATTR dmx_input_isr (struct uart *uart, enum uart_rx_isr_event event, void *arg, BaseType_t *task_woken)
+{
+  struct dmx_input *in = arg;
+  size_t len = uart_isr_rx_len(uart);
+
+  switch (event) {
+    case UART_RX_ISR_DATA:
+      dmx_input_isr_process(in, len);
+
+      break;
+
+    case UART_RX_ISR_ERROR:
+      stats_counter_increment(&in->stats.rx_error);
+
+      // a framing error is expected for the start of the break following each frame
+      // fallthrough
+
+    case UART_RX_ISR_BREAK:
+      // the last byte is the invalid break byte
+      if (len) {
+        dmx_input_isr_process(in, len - 1);
+        uart_isr_rx_skip(uart, 1);
+      }
+
+      dmx_input_isr_frame(in, task_woken);
+
+      if (event == UART_RX_ISR_BREAK) {
+        stats_counter_increment(&in->stats.rx_break);
+
+        in->state = DMX_INPUT_STATE_CMD;
+      } else {
+        in->state = DMX_INPUT_STATE_BREAK;
+      }
+
+      break;
+
+    case UART_RX_ISR_OVERFLOW:
+      stats_counter_increment(&in->stats.rx_overflow);
+
+      // drop frame in progress
+      in->state = DMX_INPUT_STATE_BREAK;
+      in->state_len = 0;
+
+      break;
+  }
+}
+#endif
+
 int dmx_input_open (struct dmx_input *in, struct uart *uart)
 {
   int err;
@@ -97,6 +278,23 @@ int dmx_input_open (struct dmx_input *in, struct uart *uart)
   in->stop = false;
   in->state = DMX_INPUT_STATE_BREAK;
   in->state_len = 0;
+  in->frame_time = 0;
+
+#if DMX_INPUT_ISR_SUPPORTED
+  if (in->options.data_alt) {
+    in->isr_task = NULL;
+    in->isr_back = 0;
+    in->isr_ready = false;
+    in->isr_busy = false;
+
+    if ((err = uart_start_rx_isr(uart, dmx_input_isr, in))) {
+      LOG_ERROR("uart_start_rx_isr");
+      uart_close_rx(uart);
+      in->uart = NULL;
+      return err;
+    }
+  }
+#endif
 
   // enable input
   if (in->options.gpio_options) {
@@ -235,6 +433,13 @@ int dmx_input_read (struct dmx_input *in)
     return -1;
   }
 
+#if DMX_INPUT_ISR_SUPPORTED
+  if (in->options.data_alt) {
+    LOG_ERROR("use dmx_input_read_frame() with data_alt");
+    return -1;
+  }
+#endif
+
   if (in->stop) {
     return 0;
   }
@@ -263,6 +468,89 @@ int dmx_input_read (struct dmx_input *in)
   return in->state_len;
 }
 
+#if DMX_INPUT_ISR_SUPPORTED
+static int dmx_input_read_isr_frame (struct dmx_input *in, struct dmx_input_frame *frame)
+{
+  bool ready = false;
+
+  in->isr_task = xTaskGetCurrentTaskHandle();
+
+  // release previous frame
+  taskENTER_CRITICAL(&in->isr_mux);
+
+  in->isr_busy = false;
+
+  taskEXIT_CRITICAL(&in->isr_mux);
+
+  while (!ready) {
+    if (in->stop) {
+      return 0;
+    }
+
+    taskENTER_CRITICAL(&in->isr_mux);
+
+    if ((ready = in->isr_ready)) {
+      *frame = in->isr_frame;
+
+      // ISR will not swap frames until released
+      in->isr_ready = false;
+      in->isr_busy = true;
+    }
+
+    taskEXIT_CRITICAL(&in->isr_mux);
+
+    if (!ready) {
+      // notified by ISR for each frame, or dmx_input_stop()
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+  }
+
+  return frame->len;
+}
+#endif
+
+int dmx_input_read_frame (struct dmx_input *in, struct dmx_input_frame *frame)
+{
+  int read;
+
+  if (!in->uart) {
+    LOG_ERROR("no open uart");
+    return -1;
+  }
+
+#if DMX_INPUT_ISR_SUPPORTED
+  if (in->options.data_alt) {
+    if ((read = dmx_input_read_isr_frame(in, frame)) <= 0) {
+      return read;
+    }
+
+    stats_gauge_sample(&in->stats.data_len, read);
+  } else
+#endif
+  {
+    if ((read = dmx_input_read(in)) <= 0) {
+      return read;
+    }
+
+    *frame = (struct dmx_input_frame) {
+      .data   = in->options.data,
+      .len    = read,
+      .slots  = in->state_data_index,
+      .time   = esp_timer_get_time(),
+    };
+  }
+
+  if (in->frame_time && frame->time > in->frame_time) {
+    stats_gauge_sample(&in->stats.frame_rate, 1000000 / (frame->time - in->frame_time));
+  }
+
+  stats_gauge_sample(&in->stats.frame_slots, frame->slots);
+
+  in->frame_time = frame->time;
+
+  return read;
+}
+
 int dmx_input_stop (struct dmx_input *in)
 {
   int err;
@@ -274,6 +562,16 @@ int dmx_input_stop (struct dmx_input *in)
 
   in->stop = true;
 
+#if DMX_INPUT_ISR_SUPPORTED
+  if (in->options.data_alt) {
+    if (in->isr_task) {
+      xTaskNotifyGive(in->isr_task);
+    }
+
+    return 0;
+  }
+#endif
+
   if ((err = uart_abort_read(in->uart))) {
     LOG_ERROR("uart_abort_read");
     return err;
@@ -298,6 +596,12 @@ int dmx_input_close (struct dmx_input *in)
     gpio_out_clear(in->options.gpio_options);
   }
 
+#if DMX_INPUT_ISR_SUPPORTED
+  if (in->options.data_alt && (err = uart_stop_rx_isr(in->uart))) {
+    LOG_WARN("uart_stop_rx_isr");
+  }
+#endif
+
   if ((err = uart_close_rx(in->uart))) {
     LOG_ERROR("uart_close_rx");
     return err;
@@ -2,6 +2,11 @@
 
 #include <dmx.h>
 
+#if DMX_INPUT_ISR_SUPPORTED
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
+
 enum dmx_input_state {
   DMX_INPUT_STATE_BREAK = 0,
   DMX_INPUT_STATE_CMD,
@@ -22,4 +27,17 @@ struct dmx_input {
   enum dmx_cmd state_cmd;
   unsigned state_data_index;
   size_t state_len;
+
+  // read_frame
+  int64_t frame_time;
+
+#if DMX_INPUT_ISR_SUPPORTED
+  // ISR writes into frames[isr_back], task reads frames[!isr_back] while isr_busy
+  portMUX_TYPE isr_mux;
+  TaskHandle_t isr_task;
+  uint8_t *isr_frames[2];
+  unsigned isr_back;
+  bool isr_ready, isr_busy;
+  struct dmx_input_frame isr_frame;
+#endif
 };
@@ -5,6 +5,11 @@
 #include <logging.h>
 
 #include <stdlib.h>
+#include <string.h>
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  #include <esp_attr.h>
+#endif
 
 #define DMX_BREAK_BITS 23 // 4us per bit, 92us min break
 #define DMX_MARK_AFTER_BREAK_BITS 3 // 4us per bit, 12us MAB
@@ -15,10 +20,20 @@ void dmx_output_stats_reset (struct dmx_output_stats *stats)
   stats_timer_init(&stats->uart_tx);
 
   stats_counter_init(&stats->tx_error);
+  stats_counter_init(&stats->tx_refresh);
 
   stats_counter_init(&stats->cmd_dimmer);
 
   stats_gauge_init(&stats->data_len);
+#if DMX_OUTPUT_BULK_SUPPORTED
+  stats_gauge_init(&stats->tx_rate);
+  stats_gauge_init(&stats->tx_isr);
+#endif
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  stats_gauge_init(&stats->refresh_rate);
+  stats_gauge_init(&stats->refresh_frame);
+  stats_gauge_init(&stats->refresh_jitter);
+#endif
 }
 
 int dmx_output_init (struct dmx_output *out, struct dmx_output_options options)
@@ -61,9 +76,19 @@ void dmx_output_stats(struct dmx_output *out, struct dmx_output_stats *stats, bo
   stats->uart_tx = stats_timer_copy(&out->stats.uart_tx);
 
   stats->tx_error = stats_counter_copy(&out->stats.tx_error);
+  stats->tx_refresh = stats_counter_copy(&out->stats.tx_refresh);
   stats->cmd_dimmer = stats_counter_copy(&out->stats.cmd_dimmer);
 
   stats->data_len = stats_gauge_copy(&out->stats.data_len);
+#if DMX_OUTPUT_BULK_SUPPORTED
+  stats->tx_rate = stats_gauge_copy(&out->stats.tx_rate);
+  stats->tx_isr = stats_gauge_copy(&out->stats.tx_isr);
+#endif
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  stats->refresh_rate = stats_gauge_copy(&out->stats.refresh_rate);
+  stats->refresh_frame = stats_gauge_copy(&out->stats.refresh_frame);
+  stats->refresh_jitter = stats_gauge_copy(&out->stats.refresh_jitter);
+#endif
 
   if (reset) {
     dmx_output_stats_reset(&out->stats);
@@ -101,6 +126,273 @@ int dmx_output_open (struct dmx_output *out, struct uart *uart)
   return 0;
 }
 
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+/* Start next frame with a break, swapping in any updated back frame */
+static enum uart_tx_isr_event IRAM_ATTR dmx_output_refresh_start(struct uart *uart, struct dmx_output_refresh *refresh)
+{
+  int64_t time;
+
+  if (refresh->timer && !refresh->pending) {
+    // wait for dmx_output_refresh_trigger()
+    return UART_TX_ISR_STOP;
+  }
+
+  time = esp_timer_get_time();
+
+  if (refresh->frame_start) {
+    refresh->frame_period = time - refresh->frame_start;
+  }
+
+  refresh->frame_start = time;
+
+  if (refresh->back_ready) {
+    unsigned front = refresh->front;
+
+    refresh->front = refresh->back;
+    refresh->back = front;
+    refresh->back_ready = false;
+  }
+
+  // send break/mark per spec minimums once the TX FIFO is empty, immediately followed by the frame data
+  uart_isr_tx_break(uart, DMX_BREAK_BITS, DMX_MARK_AFTER_BREAK_BITS);
+
+  refresh->state = DMX_OUTPUT_REFRESH_BREAK;
+  refresh->offset = 0;
+  refresh->pending = false;
+
+  return UART_TX_ISR_BREAK;
+}
+
+static enum uart_tx_isr_event IRAM_ATTR dmx_output_refresh_isr(struct uart *uart, enum uart_tx_isr_event event, void *arg)
+{
+  struct dmx_output *out = arg;
+  struct dmx_output_refresh *refresh = out->refresh;
+  const struct dmx_output_frame *frame;
+  enum uart_tx_isr_event ret = UART_TX_ISR_STOP;
+
+  taskENTER_CRITICAL_ISR(&refresh->mux);
+
+  switch (refresh->state) {
+    case DMX_OUTPUT_REFRESH_IDLE:
+      // start next frame, or wait for dmx_output_refresh_trigger()
+      ret = dmx_output_refresh_start(uart, refresh);
+
+      break;
+
+    case DMX_OUTPUT_REFRESH_BREAK:
+      if (event != UART_TX_ISR_BREAK) {
+        // triggered while still waiting for break
+        ret = UART_TX_ISR_BREAK;
+        break;
+      }
+
+      refresh->state = DMX_OUTPUT_REFRESH_DATA;
+
+      // fallthrough
+    case DMX_OUTPUT_REFRESH_DATA:
+      frame = &refresh->frames[refresh->front];
+
+      refresh->offset += uart_isr_tx_write(uart, frame->buf + refresh->offset, frame->len - refresh->offset);
+
+      if (refresh->offset < frame->len) {
+        ret = UART_TX_ISR_EMPTY;
+        break;
+      }
+
+      stats_counter_increment(&out->stats.tx_refresh);
+
+      refresh->frame_time = esp_timer_get_time() - refresh->frame_start;
+      refresh->frame_count++;
+
+      refresh->state = DMX_OUTPUT_REFRESH_IDLE;
+
+      // continue back-to-back with the break for the next frame, or wait for dmx_output_refresh_trigger()
+      ret = dmx_output_refresh_start(uart, refresh);
+
+      break;
+  }
+
+  taskEXIT_CRITICAL_ISR(&refresh->mux);
+
+  return ret;
+}
+
+void dmx_output_refresh_trigger(struct dmx_output *out)
+{
+  struct dmx_output_refresh *refresh = out->refresh;
+
+  taskENTER_CRITICAL(&refresh->mux);
+
+  // if the previous frame is still in progress, the next frame will start immediately once it completes
+  refresh->pending = true;
+
+  taskEXIT_CRITICAL(&refresh->mux);
+
+  uart_trigger_tx_isr(out->uart);
+}
+
+/* Sample ISR frame timing into stats, from task context */
+void dmx_output_refresh_stats(struct dmx_output *out)
+{
+  struct dmx_output_refresh *refresh = out->refresh;
+  uint32_t frame_period, frame_time, frame_nominal;
+  unsigned frame_count;
+
+  taskENTER_CRITICAL(&refresh->mux);
+
+  frame_period = refresh->frame_period;
+  frame_time = refresh->frame_time;
+  frame_count = refresh->frame_count;
+  refresh->frame_count = 0;
+
+  taskEXIT_CRITICAL(&refresh->mux);
+
+  if (!frame_count || !frame_period) {
+    return;
+  }
+
+  if (refresh->timer) {
+    frame_nominal = 1000000 / refresh->timer->rate;
+  } else {
+    frame_nominal = frame_time;
+  }
+
+  stats_gauge_sample(&out->stats.refresh_rate, 1000000 / frame_period);
+  stats_gauge_sample(&out->stats.refresh_frame, frame_time);
+  stats_gauge_sample(&out->stats.refresh_jitter, frame_period > frame_nominal ? frame_period - frame_nominal : frame_nominal - frame_period);
+}
+
+static void dmx_output_refresh_init(struct dmx_output_refresh *refresh, struct dmx_output_timer *timer)
+{
+  portMUX_INITIALIZE(&refresh->mux);
+
+  refresh->timer = timer;
+
+  // all zero channels
+  for (unsigned i = 0; i < 2; i++) {
+    refresh->frames[i].len = DMX_OUTPUT_REFRESH_SIZE;
+    memset(refresh->frames[i].buf, 0, sizeof(refresh->frames[i].buf));
+  }
+
+  refresh->front = 0;
+  refresh->back = 1;
+  refresh->back_ready = false;
+
+  refresh->state = DMX_OUTPUT_REFRESH_IDLE;
+  refresh->offset = 0;
+  refresh->pending = true;
+
+  refresh->frame_start = 0;
+  refresh->frame_period = 0;
+  refresh->frame_time = 0;
+  refresh->frame_count = 0;
+}
+
+int dmx_output_start (struct dmx_output *out, struct uart *uart, struct dmx_output_timer *timer)
+{
+  int err;
+
+  if (out->refresh_started) {
+    LOG_ERROR("already started");
+    return -1;
+  }
+
+  if (!out->refresh && !(out->refresh = calloc(1, sizeof(*out->refresh)))) {
+    LOG_ERROR("calloc");
+    return -1;
+  }
+
+  if ((err = dmx_output_open(out, uart))) {
+    return err;
+  }
+
+  dmx_output_refresh_init(out->refresh, timer);
+
+  LOG_DEBUG("uart=%p timer=%p", uart, timer);
+
+  if ((err = uart_start_tx_isr(uart, dmx_output_refresh_isr, out))) {
+    LOG_ERROR("uart_start_tx_isr");
+    goto error;
+  }
+
+  if (timer && (err = dmx_output_timer_add(timer, out))) {
+    LOG_ERROR("dmx_output_timer_add");
+    goto stop_error;
+  }
+
+  out->refresh_started = true;
+
+  return 0;
+
+stop_error:
+  if (uart_stop_tx_isr(uart, portMAX_DELAY)) {
+    LOG_WARN("uart_stop_tx_isr");
+  }
+
+error:
+  dmx_output_close(out);
+
+  return -1;
+}
+
+int dmx_output_stop (struct dmx_output *out)
+{
+  if (!out->refresh_started) {
+    LOG_DEBUG("not started");
+    return 1;
+  }
+
+  if (out->refresh->timer) {
+    dmx_output_timer_remove(out->refresh->timer, out);
+  }
+
+  // waits for any partial frame to complete
+  if (uart_stop_tx_isr(out->uart, portMAX_DELAY)) {
+    LOG_WARN("uart_stop_tx_isr");
+  }
+
+  out->refresh_started = false;
+
+  return dmx_output_close(out);
+}
+
+static int dmx_output_refresh_write (struct dmx_output *out, enum dmx_cmd cmd, void *data, size_t len)
+{
+  struct dmx_output_refresh *refresh = out->refresh;
+  struct dmx_output_frame *frame;
+
+  if (len > DMX_OUTPUT_REFRESH_SIZE - 1) {
+    LOG_ERROR("len=%u exceeds %u slots", len, DMX_OUTPUT_REFRESH_SIZE - 1);
+    return -1;
+  }
+
+  // the ISR will not swap in the back frame while we are updating it
+  taskENTER_CRITICAL(&refresh->mux);
+
+  refresh->back_ready = false;
+  frame = &refresh->frames[refresh->back];
+
+  taskEXIT_CRITICAL(&refresh->mux);
+
+  frame->buf[0] = cmd;
+  memcpy(frame->buf + 1, data, len);
+  frame->len = 1 + len;
+
+  taskENTER_CRITICAL(&refresh->mux);
+
+  refresh->back_ready = true;
+
+  taskEXIT_CRITICAL(&refresh->mux);
+
+  if (!refresh->timer) {
+    // back-to-back refresh has no timer to sample stats
+    dmx_output_refresh_stats(out);
+  }
+
+  return 0;
+}
+#endif
+
 int dmx_output_write (struct dmx_output *out, enum dmx_cmd cmd, void *data, size_t len)
 {
   int err;
@@ -113,6 +405,40 @@ int dmx_output_write (struct dmx_output *out, enum dmx_cmd cmd, void *data, size
   stats_counter_increment(&out->stats.cmd_dimmer);
   stats_gauge_sample(&out->stats.data_len, len);
 
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  if (out->refresh_started) {
+    if ((err = dmx_output_refresh_write(out, cmd, data, len))) {
+      stats_counter_increment(&out->stats.tx_error);
+    }
+
+    return err;
+  }
+#endif
+
+#if DMX_OUTPUT_BULK_SUPPORTED
+  WITH_STATS_TIMER(&out->stats.uart_tx) {
+    uint8_t start_code = cmd;
+    struct uart_tx_bulk_stats bulk_stats;
+
+    // send break/mark per spec minimums, start code and data as a single frame written from the UART ISR
+    const struct uart_tx_seg segs[] = {
+      { .break_bits = DMX_BREAK_BITS, .mark_bits = DMX_MARK_AFTER_BREAK_BITS, .buf = &start_code, .len = 1 },
+      { .buf = data, .len = len },
+    };
+
+    if ((err = uart_write_bulk(out->uart, segs, 2, portMAX_DELAY, &bulk_stats))) {
+      LOG_ERROR("uart_write_bulk");
+      goto error;
+    }
+
+    if (bulk_stats.us) {
+      stats_gauge_sample(&out->stats.tx_rate, (uint64_t) bulk_stats.bytes * 1000000 / bulk_stats.us);
+    }
+    if (bulk_stats.bytes) {
+      stats_gauge_sample(&out->stats.tx_isr, bulk_stats.isr_cycles / bulk_stats.bytes);
+    }
+  }
+#else
   WITH_STATS_TIMER(&out->stats.uart_tx) {
     // send break/mark per spec minimums for transmit; actual timings will vary, these are minimums
     if ((err = uart_break(out->uart, DMX_BREAK_BITS, DMX_MARK_AFTER_BREAK_BITS, portMAX_DELAY))) {
@@ -143,6 +469,7 @@ int dmx_output_write (struct dmx_output *out, enum dmx_cmd cmd, void *data, size
       goto error;
     }
   }
+#endif
 
   return 0;
 
@@ -3,9 +3,76 @@
 #include <dmx_output.h>
 #include <dmx_output_stats.h>
 
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  #include <esp_timer.h>
+  #include <freertos/FreeRTOS.h>
+
+  // start code + slots
+  #define DMX_OUTPUT_REFRESH_SIZE (1 + 512)
+
+  struct dmx_output_frame {
+    unsigned len;
+    uint8_t buf[DMX_OUTPUT_REFRESH_SIZE];
+  };
+
+  enum dmx_output_refresh_state {
+    DMX_OUTPUT_REFRESH_IDLE,
+    DMX_OUTPUT_REFRESH_BREAK,
+    DMX_OUTPUT_REFRESH_DATA,
+  };
+
+  // outputs started on the same timer
+  #define DMX_OUTPUT_TIMER_SIZE 8
+
+  struct dmx_output_timer {
+    portMUX_TYPE mux;
+    esp_timer_handle_t esp_timer;
+    unsigned rate;
+
+    struct dmx_output *outputs[DMX_OUTPUT_TIMER_SIZE];
+    unsigned count;
+  };
+
+  struct dmx_output_refresh {
+    portMUX_TYPE mux;
+
+    // refresh on timer ticks, or back-to-back if NULL
+    struct dmx_output_timer *timer;
+
+    // ISR outputs from front frame, dmx_output_write() updates back frame
+    struct dmx_output_frame frames[2];
+    unsigned front, back;
+    bool back_ready;
+
+    // ISR state
+    enum dmx_output_refresh_state state;
+    unsigned offset;
+    bool pending;
+
+    // ISR timing of the most recently completed frame, in us, from break until the last slot is written to the TX FIFO
+    int64_t frame_start;
+    uint32_t frame_period, frame_time;
+    unsigned frame_count;
+  };
+
+  /* dmx_output.c */
+  void dmx_output_refresh_trigger(struct dmx_output *out);
+  void dmx_output_refresh_stats(struct dmx_output *out);
+
+  /* dmx_output_timer.c */
+  int dmx_output_timer_add(struct dmx_output_timer *timer, struct dmx_output *out);
+  void dmx_output_timer_remove(struct dmx_output_timer *timer, struct dmx_output *out);
+#endif
+
 struct dmx_output {
   struct dmx_output_options options;
   struct dmx_output_stats stats;
 
   struct uart *uart;
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  // allocated on first dmx_output_start()
+  struct dmx_output_refresh *refresh;
+  bool refresh_started;
+#endif
 };
@@ -0,0 +1,135 @@
+#include <dmx_output.h>
+#include "dmx_output.h"
+
+#include <logging.h>
+
+#include <stdlib.h>
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  #include <esp_err.h>
+
+static void dmx_output_timer_tick(void *arg)
+{
+  struct dmx_output_timer *timer = arg;
+  struct dmx_output *outputs[DMX_OUTPUT_TIMER_SIZE];
+  unsigned count;
+
+  // trigger all outputs back-to-back, starting each frame at the same time
+  taskENTER_CRITICAL(&timer->mux);
+
+  for (unsigned i = 0; i < timer->count; i++) {
+    dmx_output_refresh_trigger(timer->outputs[i]);
+
+    outputs[i] = timer->outputs[i];
+  }
+
+  count = timer->count;
+
+  taskEXIT_CRITICAL(&timer->mux);
+
+  for (unsigned i = 0; i < count; i++) {
+    dmx_output_refresh_stats(outputs[i]);
+  }
+}
+
+int dmx_output_timer_new (struct dmx_output_timer **timerp, unsigned rate)
+{
+  struct dmx_output_timer *timer;
+  esp_timer_create_args_t timer_args = {
+    .callback = dmx_output_timer_tick,
+    .name     = "dmx-output",
+  };
+  int err;
+
+  if (!rate) {
+    LOG_ERROR("rate must be non-zero");
+    return -1;
+  }
+
+  if (!(timer = calloc(1, sizeof(*timer)))) {
+    LOG_ERROR("calloc");
+    return -1;
+  }
+
+  portMUX_INITIALIZE(&timer->mux);
+
+  timer->rate = rate;
+
+  timer_args.arg = timer;
+
+  if ((err = esp_timer_create(&timer_args, &timer->esp_timer))) {
+    LOG_ERROR("esp_timer_create: %s", esp_err_to_name(err));
+    goto error;
+  }
+
+  *timerp = timer;
+
+  return 0;
+
+error:
+  free(timer);
+
+  return -1;
+}
+
+int dmx_output_timer_add (struct dmx_output_timer *timer, struct dmx_output *out)
+{
+  unsigned count;
+  int err;
+
+  taskENTER_CRITICAL(&timer->mux);
+
+  if ((count = timer->count) < DMX_OUTPUT_TIMER_SIZE) {
+    timer->outputs[timer->count++] = out;
+  }
+
+  taskEXIT_CRITICAL(&timer->mux);
+
+  if (count >= DMX_OUTPUT_TIMER_SIZE) {
+    LOG_ERROR("too many outputs: count=%u", count);
+    return -1;
+  }
+
+  if (count == 0) {
+    LOG_DEBUG("start rate=%u", timer->rate);
+
+    if ((err = esp_timer_start_periodic(timer->esp_timer, 1000000 / timer->rate))) {
+      LOG_ERROR("esp_timer_start_periodic: %s", esp_err_to_name(err));
+      dmx_output_timer_remove(timer, out);
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+void dmx_output_timer_remove (struct dmx_output_timer *timer, struct dmx_output *out)
+{
+  unsigned count;
+  int err;
+
+  taskENTER_CRITICAL(&timer->mux);
+
+  for (unsigned i = 0; i < timer->count; i++) {
+    if (timer->outputs[i] != out) {
+      continue;
+    }
+
+    timer->outputs[i] = timer->outputs[--timer->count];
+    break;
+  }
+
+  count = timer->count;
+
+  taskEXIT_CRITICAL(&timer->mux);
+
+  if (count == 0) {
+    LOG_DEBUG("stop");
+
+    // not running if the first dmx_output_timer_add() failed
+    if ((err = esp_timer_stop(timer->esp_timer)) && err != ESP_ERR_INVALID_STATE) {
+      LOG_WARN("esp_timer_stop: %s", esp_err_to_name(err));
+    }
+  }
+}
+#endif
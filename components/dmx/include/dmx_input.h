@@ -4,12 +4,25 @@
 #include <gpio.h>
 #include <uart.h>
 
+// SOC supports receiving frames from the UART ISR
+#define DMX_INPUT_ISR_SUPPORTED UART_RX_ISR_SUPPORTED
+
 struct dmx_input;
 struct dmx_input_options {
   /* Write channel data */
   uint8_t *data;
   size_t size;
 
+#if DMX_INPUT_ISR_SUPPORTED
+  /*
+   * Optional second buffer of `size` bytes, alternating with `data`.
+   *
+   * If given, DMX frames are received directly into the data buffers from the UART ISR, and must be read using
+   * `dmx_input_read_frame()`.
+   */
+  uint8_t *data_alt;
+#endif
+
   /* Offset start of data to 1-indexed channel address*/
   unsigned address;
 
@@ -18,6 +31,20 @@ struct dmx_input_options {
   gpio_pins_t gpio_out_pins;
 };
 
+struct dmx_input_frame {
+  /* Channel data, valid until the next dmx_input_read_frame() */
+  const uint8_t *data;
+
+  /* Number of DMX channels updated in data */
+  size_t len;
+
+  /* Total number of DMX slots received, excluding the start code */
+  unsigned slots;
+
+  /* Time of frame completion, in esp_timer_get_time() us */
+  int64_t time;
+};
+
 int dmx_input_new (struct dmx_input **inp, struct dmx_input_options options);
 
 /*
@@ -30,12 +57,21 @@ int dmx_input_open (struct dmx_input *in, struct uart *uart);
 /*
  * Read one DMX packet, processing up to options->size DMX channels into options->data, starting at DMX channel options->address.
  *
+ * Not supported with options->data_alt.
+ *
  * @return <0 on error, 0 if stopped, or number of DMX channels updated.
  */
 int dmx_input_read (struct dmx_input *in);
 
 /*
- * Stop dmx_input_read().
+ * Read one DMX packet into either options->data or options->data_alt.
+ *
+ * @return <0 on error, 0 if stopped, or number of DMX channels updated.
+ */
+int dmx_input_read_frame (struct dmx_input *in, struct dmx_input_frame *frame);
+
+/*
+ * Stop dmx_input_read() / dmx_input_read_frame().
  */
 int dmx_input_stop (struct dmx_input *in);
 
@@ -18,6 +18,12 @@ struct dmx_input_stats {
   struct stats_counter cmd_dimmer, cmd_unknown;
 
   struct stats_gauge data_len;
+
+  /* Complete frames dropped before being read */
+  struct stats_counter frame_drop;
+
+  /* Measured input refresh rate (Hz) and slots per frame */
+  struct stats_gauge frame_rate, frame_slots;
 };
 
 /*
@@ -4,6 +4,10 @@
 #include <gpio.h>
 #include <uart.h>
 
+// SOC supports continuous ISR-driven refresh
+#define DMX_OUTPUT_REFRESH_SUPPORTED UART_TX_ISR_SUPPORTED
+#define DMX_OUTPUT_BULK_SUPPORTED UART_TX_ISR_SUPPORTED
+
 struct dmx_output;
 struct dmx_output_options {
   
@@ -25,11 +29,44 @@ int dmx_output_new (struct dmx_output **outp, struct dmx_output_options options)
  */
 int dmx_output_open (struct dmx_output *out, struct uart *uart);
 
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+struct dmx_output_timer;
+
+/*
+ * Create a refresh timer at the given rate (Hz), shared by any number of outputs.
+ *
+ * Each timer tick triggers the next refresh frame on all started outputs at once, aligning the frames across UARTs.
+ * The timer only runs while outputs are started.
+ */
+int dmx_output_timer_new (struct dmx_output_timer **timerp, unsigned rate);
+
+/*
+ * Open UART for TX, and start continuously refreshing the DMX output from the UART ISR.
+ *
+ * Each refresh frame consists of a break + MAB, followed by the start code + data slots, on each tick of the given
+ * timer, or back-to-back at the maximum rate if NULL. All zero channels are output until the first `dmx_output_write()`.
+ *
+ * The UART TX remains open until `dmx_output_stop()`.
+ *
+ * Returns <0 on error, 0 on success, >0 if UART not setup.
+ */
+int dmx_output_start (struct dmx_output *out, struct uart *uart, struct dmx_output_timer *timer);
+
+/*
+ * Stop refreshing DMX output, and close UART for TX.
+ *
+ * Returns >0 if not started.
+ */
+int dmx_output_stop (struct dmx_output *out);
+#endif
+
 /*
  * Write cmd + data on UART TX.
  *
  * DMX output must be open!
  *
+ * If started using `dmx_output_start()`, this only updates the frame for the next refresh, without blocking.
+ *
  * Returns <0 on error, 0 on success, >0 if UART not open.
  */
 int dmx_output_write (struct dmx_output *out, enum dmx_cmd cmd, void *data, size_t len);
@@ -8,9 +8,29 @@ struct dmx_output_stats {
   struct stats_timer uart_tx;
 
   struct stats_counter tx_error;
+  struct stats_counter tx_refresh;
   struct stats_counter cmd_dimmer;
 
   struct stats_gauge data_len;
+
+#if DMX_OUTPUT_BULK_SUPPORTED
+  // bytes/s from start of break until TX complete
+  struct stats_gauge tx_rate;
+
+  // UART ISR CPU cycles per byte
+  struct stats_gauge tx_isr;
+#endif
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  // frames/s between refresh frame starts
+  struct stats_gauge refresh_rate;
+
+  // us from start of refresh frame break until the last slot is written
+  struct stats_gauge refresh_frame;
+
+  // us deviation of refresh frame period from the timer period, or frame time if back-to-back
+  struct stats_gauge refresh_jitter;
+#endif
 };
 
 /*
@@ -204,7 +204,7 @@ int fseq_read_headers(struct fseq *fseq)
 
 int fseq_seek_frame(struct fseq *fseq, unsigned frame)
 {
-  unsigned offset = fseq->header.data_offset + frame * fseq->header.channel_count;
+  unsigned offset = fseq->header.data_offset + frame * fseq->header.channel_count + fseq_get_read_offset(fseq);
 
   if (fseek(fseq->file, offset, SEEK_SET)) {
     LOG_ERROR("fseek %u: %s", offset, strerror(errno));
@@ -216,8 +216,24 @@ int fseq_seek_frame(struct fseq *fseq, unsigned frame)
 
 int fseq_read_frame(struct fseq *fseq, struct fseq_frame *frame)
 {
-  if (!fread(frame->buf, frame->size, 1, fseq->file)) {
-    LOG_ERROR("fread %ux1: %s", frame->size, strerror(errno));
+  size_t size = fseq_get_read_size(fseq);
+  long skip = fseq->header.channel_count - size;
+
+  if (frame->size < size) {
+    LOG_ERROR("frame size=%u is too small for read size=%u", frame->size, size);
+    return -1;
+  }
+
+  if (size && !fread(frame->buf, size, 1, fseq->file)) {
+    LOG_ERROR("fread %ux1: %s", size, strerror(errno));
+    return -1;
+  }
+
+  frame->offset = fseq_get_read_offset(fseq);
+
+  // skip to read offset within next frame
+  if (skip && fseek(fseq->file, skip, SEEK_CUR)) {
+    LOG_ERROR("fseek %ld: %s", skip, strerror(errno));
     return -1;
   }
 
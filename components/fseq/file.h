@@ -30,7 +30,7 @@ struct __attribute__((packed)) fseq_compression_block {
 
 struct __attribute__((packed)) fseq_sparse_range {
   unsigned start_index : 24;
-  unsigned end_offset : 24;
+  unsigned end_offset : 24; // channel count, relative to start_index
 };
 
 struct __attribute__((packed)) fseq_variable_header {
@@ -1,23 +1,97 @@
 #include <fseq.h>
 #include "fseq.h"
 
+#include <system_heap.h>
+
 #include <stdlib.h>
 
 #include <logging.h>
 
+static struct system_heap_usage fseq_heap_usage = SYSTEM_HEAP_USAGE("fseq");
+
+/* Clip 0-based frame data channel and count to the frame data, returning size of available channels */
+static size_t fseq_clip_channels(struct fseq *fseq, unsigned channel, unsigned count)
+{
+  if (channel >= fseq->header.channel_count) {
+    return 0;
+  } else if (!count || count > fseq->header.channel_count - channel) {
+    return fseq->header.channel_count - channel;
+  } else {
+    return count;
+  }
+}
+
+int fseq_window(struct fseq *fseq, unsigned channel, unsigned count, struct fseq_window *window)
+{
+  size_t offset = channel, size = fseq_clip_channels(fseq, channel, count);
+
+  LOG_INFO("channel=%u count=%u -> offset=%u size=%u", channel, count, offset, size);
+
+  window->offset = offset;
+  window->size = size;
+
+  if (!size) {
+    LOG_WARN("channel=%u count=%u is not present in frame data", channel, count);
+    return 1;
+  }
+
+  if (!fseq->window) {
+    fseq->window = true;
+    fseq->window_offset = offset;
+    fseq->window_size = size;
+  } else {
+    size_t start = fseq->window_offset < offset ? fseq->window_offset : offset;
+    size_t end = fseq->window_offset + fseq->window_size > offset + size ? fseq->window_offset + fseq->window_size : offset + size;
+
+    fseq->window_offset = start;
+    fseq->window_size = end - start;
+  }
+
+  return 0;
+}
+
 int fseq_frame_new(struct fseq_frame **framep, struct fseq *fseq)
 {
   struct fseq_frame *frame;
-  size_t size = fseq_get_frame_size(fseq);
+  size_t size = fseq_get_read_size(fseq);
 
-  if (!(frame = malloc(sizeof(*frame) + size))) {
-    LOG_ERROR("malloc %u + %u", sizeof(*frame), size);
+  if (!(frame = system_heap_malloc(&fseq_heap_usage, SYSTEM_HEAP_EXTERNAL, sizeof(*frame) + size))) {
+    LOG_ERROR("system_heap_malloc %u + %u", sizeof(*frame), size);
     return -1;
   }
 
+  frame->tick = 0;
+  frame->offset = fseq_get_read_offset(fseq);
   frame->size = size;
 
   *framep = frame;
 
   return 0;
 }
+
+int fseq_frame_new_window(struct fseq_frame **framep, const struct fseq_window *window)
+{
+  struct fseq_frame *frame;
+
+  if (!(frame = system_heap_malloc(&fseq_heap_usage, SYSTEM_HEAP_EXTERNAL, sizeof(*frame) + window->size))) {
+    LOG_ERROR("system_heap_malloc %u + %u", sizeof(*frame), window->size);
+    return -1;
+  }
+
+  frame->tick = 0;
+  frame->offset = window->offset;
+  frame->size = window->size;
+
+  *framep = frame;
+
+  return 0;
+}
+
+void fseq_frame_free(struct fseq_frame *frame)
+{
+  if (!frame) {
+    return;
+  }
+
+  system_heap_free(&fseq_heap_usage, frame, fseq_frame_size(frame));
+}
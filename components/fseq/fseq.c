@@ -148,6 +148,8 @@ int fseq_read(struct fseq *fseq, struct fseq_frame *frame)
     return ret;
   }
 
+  frame->tick = fseq->tick;
+
   if ((err = fseq_read_frame(fseq, frame))) {
     return err;
   }
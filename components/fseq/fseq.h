@@ -3,6 +3,7 @@
 #include <fseq.h>
 #include "file.h"
 
+#include <stdbool.h>
 #include <stdio.h>
 
 struct fseq {
@@ -15,6 +16,10 @@ struct fseq {
   struct fseq_variable_header **variable_headers;
   unsigned variable_headers_count;
 
+  // span of frame data covering all windows
+  bool window;
+  size_t window_offset, window_size;
+
   // state
   enum fseq_mode mode;
   unsigned frame;
@@ -32,6 +37,17 @@ static inline size_t fseq_get_frame_size(struct fseq *fseq)
   return fseq->header.channel_count;
 }
 
+/* Return frame data offset/size for each fseq_read_frame() */
+static inline size_t fseq_get_read_offset(struct fseq *fseq)
+{
+  return fseq->window ? fseq->window_offset : 0;
+}
+
+static inline size_t fseq_get_read_size(struct fseq *fseq)
+{
+  return fseq->window ? fseq->window_size : fseq->header.channel_count;
+}
+
 static inline TickType_t fseq_get_frame_ticks(struct fseq *fseq)
 {
   return fseq->header.frame_step_ms / portTICK_PERIOD_MS;
@@ -22,23 +22,67 @@ enum fseq_state {
 
 struct fseq;
 struct fseq_frame {
+  TickType_t tick; // playout tick
+  size_t offset; // frame data offset of buf[0]
   size_t size;
   uint8_t buf[];
 };
 
+/* Span of channels within the frame data */
+struct fseq_window {
+  size_t offset;
+  size_t size;
+};
+
 /* Return size of fseq_frame in bytes (metadata + uint8_t buf).  */
 static inline size_t fseq_frame_size(const struct fseq_frame *frame)
 {
   return sizeof(*frame) + frame->size;
 }
 
+/* Return pointer to window data within frame, NULL if empty. */
+static inline const uint8_t *fseq_frame_window(const struct fseq_frame *frame, const struct fseq_window *window)
+{
+  if (!window->size || window->offset < frame->offset || window->offset + window->size > frame->offset + frame->size) {
+    return NULL;
+  }
+
+  return frame->buf + (window->offset - frame->offset);
+}
+
 int fseq_new(struct fseq **fseqp, FILE *file);
 
+/*
+ * Limit frame reads to include the given channel window, using 0-based channel numbers.
+ * Use count=0 for all channels following the first channel.
+ *
+ * The channels are offsets within the frame data, clipped to the channels present in the frame data.
+ * For sparse files, this is the concatenated data of the sparse ranges, not the absolute channel numbers.
+ *
+ * Multiple windows may be used: each fseq_read() does a single read covering all windows, instead of the full frame.
+ * Without any windows, the full frame is read.
+ *
+ * Must be called before fseq_frame_new() and fseq_start().
+ *
+ * Returns >0 if the window is empty, without limiting frame reads.
+ */
+int fseq_window(struct fseq *fseq, unsigned channel, unsigned count, struct fseq_window *window);
+
 /*
  * Allocate frame for use with fseq.
  */
 int fseq_frame_new(struct fseq_frame **framep, struct fseq *fseq);
 
+/*
+ * Allocate frame for a copy of the window data.
+ */
+int fseq_frame_new_window(struct fseq_frame **framep, const struct fseq_window *window);
+
+/*
+ * Free frame allocated using fseq_frame_new() or fseq_frame_new_window().
+ */
+void fseq_frame_free(struct fseq_frame *frame);
+
 /*
  * Return current fseq state.
  */
@@ -60,7 +104,9 @@ TickType_t fseq_tick(struct fseq *fseq);
 bool fseq_ready(struct fseq *fseq);
 
 /*
- * Return next frame data in *frame.
+ * Return next frame data in *frame, with the tick for playout of the frame.
+ *
+ * This can be used to read ahead of the playout tick.
  *
  * Returns <0 on error, 0 on valid frame, >0 on skipped frames.
  */
@@ -20,7 +20,7 @@ struct gpio_intr_options {
 
   union {
     const struct gpio_options *host;
-    const struct gpio_i2c_dev *i2c_dev;
+    struct gpio_i2c_dev *i2c_dev;
   };
 } gpio_intr_options[GPIO_HOST_PIN_COUNT] = {};
 
@@ -45,7 +45,7 @@ static IRAM_ATTR void gpio_isr (void *arg)
           break;
 
         case GPIO_INTR_TYPE_I2C:
-          for (const struct gpio_i2c_dev *i2c_dev = options->i2c_dev; i2c_dev; i2c_dev = i2c_dev->intr_link) {
+          for (struct gpio_i2c_dev *i2c_dev = options->i2c_dev; i2c_dev; i2c_dev = i2c_dev->intr_link) {
             LOG_ISR_DEBUG("pin=%d i2c dev=%p", gpio, i2c_dev);
             gpio_i2c_intr_handler(i2c_dev, pins);
           }
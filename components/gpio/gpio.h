@@ -12,10 +12,21 @@
   #include <freertos/FreeRTOS.h>
   #include <freertos/semphr.h>
 
+  #include <gpio_i2c_stats.h>
+
   struct gpio_i2c_pca54xx_state {
     uint8_t output;
     uint8_t inversion;
     uint8_t config;
+
+    // last written register values, unchanged writes are skipped
+    bool output_written, config_written;
+    uint8_t output_write, config_write;
+
+    // last read input port, valid until the next interrupt
+    bool input_valid;
+    uint8_t input;
+    unsigned input_intr_count;
   };
 
   union gpio_i2c_state {
@@ -28,8 +39,13 @@
     SemaphoreHandle_t mutex;
     union gpio_i2c_state state;
 
-    const struct gpio_i2c_dev *intr_link; // multiple i2c devs sharing the same host intr pin
+    struct gpio_i2c_dev *intr_link; // multiple i2c devs sharing the same host intr pin
     const struct gpio_options *intr_pins[GPIO_I2C_PINS_MAX];
+
+    // incremented from ISR on every int_pin interrupt, invalidates cached input
+    volatile unsigned intr_count;
+
+    struct gpio_i2c_stats stats;
   };
 #endif
 
@@ -58,7 +74,7 @@ void gpio_intr_setup_host_pin(gpio_pin_t gpio, const struct gpio_options *option
 
 #if GPIO_I2C_ENABLED
   /* i2c.cc */
-  void gpio_i2c_intr_handler (const struct gpio_i2c_dev *i2c_dev, gpio_pins_t pins);
+  void gpio_i2c_intr_handler (struct gpio_i2c_dev *i2c_dev, gpio_pins_t pins);
 
   int gpio_i2c_setup(const struct gpio_options *options);
   int gpio_i2c_setup_input(const struct gpio_options *options, gpio_pins_t pins);
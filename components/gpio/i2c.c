@@ -6,10 +6,26 @@
 #if GPIO_I2C_ENABLED
   #include <stdlib.h>
 
-  IRAM_ATTR void gpio_i2c_intr_handler (const struct gpio_i2c_dev *dev, gpio_pins_t pins)
+  static bool gpio_i2c_intr_pins_seen(const struct gpio_i2c_dev *dev, unsigned index)
+  {
+    for (unsigned i = 0; i < index; i++) {
+      if (dev->intr_pins[i] == dev->intr_pins[index]) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  IRAM_ATTR void gpio_i2c_intr_handler (struct gpio_i2c_dev *dev, gpio_pins_t pins)
   {
     const struct gpio_options *options;
 
+    // invalidate cached input port, the first gpio_in_get() will read the device and update the cache for all pins
+    dev->intr_count++;
+
+    stats_counter_increment(&dev->stats.intr);
+
     for (unsigned i = 0; i < GPIO_I2C_PINS_MAX; i++) {
       if (!(options = dev->intr_pins[i])) {
         continue;
@@ -19,6 +35,11 @@
         continue;
       }
 
+      // only once per options, covering all of its interrupt pins
+      if (gpio_i2c_intr_pins_seen(dev, i)) {
+        continue;
+      }
+
       if (options->interrupt_func) {
         // external GPIO interrupt, unknown pins
         options->interrupt_func(options->interrupt_pins, options->interrupt_arg);
@@ -26,12 +47,26 @@
     }
   }
 
+  static void gpio_i2c_stats_init(struct gpio_i2c_stats *stats)
+  {
+    stats_timer_init(&stats->read);
+    stats_timer_init(&stats->write);
+
+    stats_counter_init(&stats->read_cached);
+    stats_counter_init(&stats->write_skip);
+    stats_counter_init(&stats->error);
+
+    stats_counter_init(&stats->intr);
+  }
+
   int gpio_i2c_init (struct gpio_i2c_dev *dev, const struct gpio_i2c_options *options)
   {
     int err;
 
     dev->options = *options;
 
+    gpio_i2c_stats_init(&dev->stats);
+
     if (!(dev->mutex = xSemaphoreCreateMutex())) {
       LOG_ERROR("xSemaphoreCreateMutex");
       return -1;
@@ -91,6 +126,22 @@
     return &dev->options;
   }
 
+  void gpio_i2c_stats(struct gpio_i2c_dev *dev, struct gpio_i2c_stats *stats, bool reset)
+  {
+    stats->read = stats_timer_copy(&dev->stats.read);
+    stats->write = stats_timer_copy(&dev->stats.write);
+
+    stats->read_cached = stats_counter_copy(&dev->stats.read_cached);
+    stats->write_skip = stats_counter_copy(&dev->stats.write_skip);
+    stats->error = stats_counter_copy(&dev->stats.error);
+
+    stats->intr = stats_counter_copy(&dev->stats.intr);
+
+    if (reset) {
+      gpio_i2c_stats_init(&dev->stats);
+    }
+  }
+
   int gpio_i2c_setup(const struct gpio_options *options)
   {
     int err;
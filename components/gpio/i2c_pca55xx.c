@@ -19,27 +19,39 @@
     return (pins) & GPIO_I2C_PCA9554_PINS_MASK;
   }
 
-  static int gpio_i2c_pca54xx_write(const struct gpio_i2c_options *options, enum pca55xx_cmd cmd, uint8_t value)
+  static int gpio_i2c_pca54xx_write(struct gpio_i2c_dev *dev, enum pca55xx_cmd cmd, uint8_t value)
   {
+    const struct gpio_i2c_options *options = &dev->options;
     uint8_t buf[] = { cmd, value };
     esp_err_t err;
 
-    if ((err = i2c_master_write_to_device(options->port, GPIO_I2C_PCA9554_ADDR(options->addr), buf, sizeof(buf), options->timeout))) {
+    WITH_STATS_TIMER(&dev->stats.write) {
+      err = i2c_master_write_to_device(options->port, GPIO_I2C_PCA9554_ADDR(options->addr), buf, sizeof(buf), options->timeout);
+    }
+
+    if (err) {
       LOG_ERROR("i2c_master_write_to_device port=%d addr=%u: %s", options->port, GPIO_I2C_PCA9554_ADDR(options->addr), esp_err_to_name(err));
+      stats_counter_increment(&dev->stats.error);
       return -1;
     }
 
     return 0;
   }
 
-  static int gpio_i2c_pca54xx_read(const struct gpio_i2c_options *options, enum pca55xx_cmd cmd, uint8_t *value)
+  static int gpio_i2c_pca54xx_read(struct gpio_i2c_dev *dev, enum pca55xx_cmd cmd, uint8_t *value)
   {
+    const struct gpio_i2c_options *options = &dev->options;
     uint8_t wbuf[] = { cmd };
     uint8_t rbuf[1] = { };
     esp_err_t err;
 
-    if ((err = i2c_master_write_read_device(options->port, GPIO_I2C_PCA9554_ADDR(options->addr), wbuf, sizeof(wbuf), rbuf, sizeof(rbuf), options->timeout))) {
+    WITH_STATS_TIMER(&dev->stats.read) {
+      err = i2c_master_write_read_device(options->port, GPIO_I2C_PCA9554_ADDR(options->addr), wbuf, sizeof(wbuf), rbuf, sizeof(rbuf), options->timeout);
+    }
+
+    if (err) {
       LOG_ERROR("i2c_master_write_to_device port=%d addr=%u: %s", options->port, GPIO_I2C_PCA9554_ADDR(options->addr), esp_err_to_name(err));
+      stats_counter_increment(&dev->stats.error);
       return -1;
     }
 
@@ -48,35 +60,90 @@
     return 0;
   }
 
-  static int gpio_i2c_pca54xx_clear(const struct gpio_i2c_dev *dev)
+  /* Write register if changed from the last written value. Called with mutex held */
+  static int gpio_i2c_pca54xx_write_cached(struct gpio_i2c_dev *dev, enum pca55xx_cmd cmd, uint8_t value, bool *writtenp, uint8_t *writep)
   {
-    uint8_t value;
     int err;
 
-    if ((err = gpio_i2c_pca54xx_read(&dev->options, PCA55XX_CMD_INPUT_PORT, &value))) {
+    if (*writtenp && *writep == value) {
+      stats_counter_increment(&dev->stats.write_skip);
+      return 0;
+    }
+
+    // unknown state on errors
+    *writtenp = false;
+
+    if ((err = gpio_i2c_pca54xx_write(dev, cmd, value))) {
       return err;
     }
 
+    *writtenp = true;
+    *writep = value;
+
     return 0;
   }
 
-  static int gpio_i2c_pca54xx_input(const struct gpio_i2c_dev *dev, uint8_t mask, uint8_t *valuep)
+  static int gpio_i2c_pca54xx_clear(struct gpio_i2c_dev *dev)
   {
     uint8_t value;
     int err;
 
-    if ((err = gpio_i2c_pca54xx_read(&dev->options, PCA55XX_CMD_INPUT_PORT, &value))) {
+    if ((err = gpio_i2c_pca54xx_read(dev, PCA55XX_CMD_INPUT_PORT, &value))) {
       return err;
     }
 
+    return 0;
+  }
+
+  /*
+   * Reading the input port also clears the interrupt, and the device will only interrupt once an input changes.
+   *
+   * With an int_pin, the input port is only read once after each interrupt, and shared by all gpio_options.
+   */
+  static int gpio_i2c_pca54xx_input(struct gpio_i2c_dev *dev, uint8_t mask, uint8_t *valuep, TickType_t timeout)
+  {
+    struct gpio_i2c_pca54xx_state *state = &dev->state.pca54xx;
+    unsigned intr_count;
+    uint8_t value;
+    int err = 0;
+
+    if (!xSemaphoreTake(dev->mutex, timeout)) {
+      LOG_ERROR("xSemaphoreTake");
+      return 1;
+    }
+
+    // any interrupt after this will invalidate the value read
+    intr_count = dev->intr_count;
+
+    if (dev->options.int_pin > 0 && state->input_valid && state->input_intr_count == intr_count) {
+      stats_counter_increment(&dev->stats.read_cached);
+
+      value = state->input;
+
+    } else if ((err = gpio_i2c_pca54xx_read(dev, PCA55XX_CMD_INPUT_PORT, &value))) {
+      state->input_valid = false;
+      goto error;
+
+    } else {
+      state->input_valid = true;
+      state->input = value;
+      state->input_intr_count = intr_count;
+    }
+
+    LOG_DEBUG("dev=%p mask=%02x -> input=%02x", dev, mask, value);
+
     *valuep = value & mask;
 
-    return 0;
+error:
+    xSemaphoreGive(dev->mutex);
+
+    return err;
   }
 
   // XXX: what timeout to use for locked operations on shared gpio_i2c_dev?
   static int gpio_i2c_pca54xx_output(struct gpio_i2c_dev *dev, uint8_t mask, uint8_t value, TickType_t timeout)
   {
+    struct gpio_i2c_pca54xx_state *state = &dev->state.pca54xx;
     int err = 0;
 
     if (!xSemaphoreTake(dev->mutex, timeout)) {
@@ -84,11 +151,11 @@
       return 1;
     }
 
-    dev->state.pca54xx.output = (dev->state.pca54xx.output & ~mask) | (value & mask);
+    state->output = (state->output & ~mask) | (value & mask);
 
-    LOG_DEBUG("dev=%p mask=%02x value=%02x -> output=%02x", dev, mask, value, dev->state.pca54xx.output);
+    LOG_DEBUG("dev=%p mask=%02x value=%02x -> output=%02x", dev, mask, value, state->output);
 
-    if ((err = gpio_i2c_pca54xx_write(&dev->options, PCA55XX_CMD_OUTPUT_PORT, dev->state.pca54xx.output))) {
+    if ((err = gpio_i2c_pca54xx_write_cached(dev, PCA55XX_CMD_OUTPUT_PORT, state->output, &state->output_written, &state->output_write))) {
       LOG_ERROR("gpio_i2c_pca54xx_write");
       goto error;
     }
@@ -102,6 +169,7 @@ error:
   // XXX: what timeout to use for locked operations on shared gpio_i2c_dev?
   static int gpio_i2c_pca54xx_config(struct gpio_i2c_dev *dev, uint8_t mask, uint8_t value, TickType_t timeout)
   {
+    struct gpio_i2c_pca54xx_state *state = &dev->state.pca54xx;
     int err = 0;
 
     if (!xSemaphoreTake(dev->mutex, timeout)) {
@@ -109,11 +177,16 @@ error:
       return 1;
     }
 
-    dev->state.pca54xx.config = (dev->state.pca54xx.config & ~mask) | (value & mask);
+    state->config = (state->config & ~mask) | (value & mask);
 
-    LOG_DEBUG("dev=%p mask=%02x value=%02x -> config=%02x", dev, mask, value, dev->state.pca54xx.config);
+    LOG_DEBUG("dev=%p mask=%02x value=%02x -> config=%02x", dev, mask, value, state->config);
+
+    if (!state->config_written || state->config_write != state->config) {
+      // pins changing between input/output will not interrupt
+      state->input_valid = false;
+    }
 
-    if ((err = gpio_i2c_pca54xx_write(&dev->options, PCA55XX_CMD_CONFIG_PORT, dev->state.pca54xx.config))) {
+    if ((err = gpio_i2c_pca54xx_write_cached(dev, PCA55XX_CMD_CONFIG_PORT, state->config, &state->config_written, &state->config_write))) {
       LOG_ERROR("gpio_i2c_pca54xx_write");
       goto error;
     }
@@ -172,7 +245,7 @@ error:
     uint8_t value;
     int err;
 
-    if ((err = gpio_i2c_pca54xx_input(i2c_dev, pca55x_pins(options->in_pins), &value))) {
+    if ((err = gpio_i2c_pca54xx_input(i2c_dev, pca55x_pins(options->in_pins), &value, i2c_dev->options.timeout))) {
       return err;
     }
 
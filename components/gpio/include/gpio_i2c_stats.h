@@ -0,0 +1,23 @@
+#pragma once
+
+#include <gpio.h>
+
+#if GPIO_I2C_ENABLED
+  #include <stats.h>
+
+  struct gpio_i2c_stats {
+    struct stats_timer read;
+    struct stats_timer write;
+
+    struct stats_counter read_cached;
+    struct stats_counter write_skip;
+    struct stats_counter error;
+
+    struct stats_counter intr;
+  };
+
+  /*
+   * Get I2C transaction stats for dev.
+   */
+  void gpio_i2c_stats(struct gpio_i2c_dev *dev, struct gpio_i2c_stats *stats, bool reset);
+#endif
@@ -3,6 +3,8 @@
 
 #include "http/http.h"
 
+#define HTTP_FILE_BUFFER_SIZE 256
+
 struct http {
     /* Stream IO */
     struct stream *read, *write;
@@ -12,6 +14,10 @@ struct http {
 
     /* Used by http_read_chunked_file */
     size_t chunk_size;
+
+    /* Used by http_file_open, instead of per-open stdio buffers */
+    char file_read_buf[HTTP_FILE_BUFFER_SIZE];
+    char file_write_buf[HTTP_FILE_BUFFER_SIZE];
 };
 
 #endif
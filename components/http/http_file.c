@@ -207,10 +207,12 @@ int http_file_write (void *cookie, const char *buf, size_t len)
 int http_file_open (struct http *http, int flags, size_t *read_content_length, FILE **filep)
 {
   const char *mode;
+  char *buf;
   cookie_io_functions_t functions = {};
 
   if (flags & HTTP_STREAM_READ) {
     mode = "r";
+    buf = http->file_read_buf;
 
     http->read_content_length = read_content_length;
     functions.read = http_file_read;
@@ -218,6 +220,7 @@ int http_file_open (struct http *http, int flags, size_t *read_content_length, F
 
   if (flags & HTTP_STREAM_WRITE) {
     mode = "w";
+    buf = http->file_write_buf;
     functions.write = http_file_write;
   }
 
@@ -232,5 +235,10 @@ int http_file_open (struct http *http, int flags, size_t *read_content_length, F
     return -1;
   }
 
+  // avoid a per-request stdio buffer allocation
+  if (setvbuf(*filep, buf, _IOFBF, HTTP_FILE_BUFFER_SIZE)) {
+    LOG_WARN("setvbuf: %s", strerror(errno));
+  }
+
   return 0;
 }
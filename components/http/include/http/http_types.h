@@ -27,6 +27,7 @@ enum http_status {
     HTTP_UNSUPPORTED_MEDIA_TYPE   = 415,
     HTTP_UNPROCESSABLE_ENTITY     = 422,
     HTTP_INTERNAL_SERVER_ERROR    = 500,
+    HTTP_SERVICE_UNAVAILABLE      = 503,
 };
 
 enum http_content_type {
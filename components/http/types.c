@@ -39,6 +39,7 @@ const char *http_status_str (enum http_status status)
         case 422:   return "Unprocessable Entity";
 
         case 500:   return "Internal Server Error";
+        case 503:   return "Service Unavailable";
 
         // hrhr
         default:    return "Unknown Response Status";
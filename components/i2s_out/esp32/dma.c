@@ -5,6 +5,7 @@
 #include <logging.h>
 
 #include <esp_heap_caps.h>
+#include <system_heap.h>
 #include <hal/i2s_ll.h>
 #include <soc/i2s_reg.h>
 
@@ -22,16 +23,24 @@
 
 #define DMA_END_BUF_SIZE (DMA_DESC_SIZE_MIN)
 
+static struct system_heap_usage i2s_out_heap_usage = SYSTEM_HEAP_USAGE("i2s-out");
+
 /* Allocate memory from appropriate heap region for DMA */
 static inline void *dma_malloc(size_t size)
 {
-  return heap_caps_malloc(size, MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+  return system_heap_malloc(&i2s_out_heap_usage, SYSTEM_HEAP_DMA, size);
 }
 
 /* Allocate memory from appropriate heap region for DMA */
 static inline void *dma_calloc(size_t count, size_t size)
 {
-  return heap_caps_calloc(count, size, MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+  return system_heap_calloc(&i2s_out_heap_usage, SYSTEM_HEAP_DMA, count, size);
+}
+
+/* Free memory allocated using dma_malloc() or dma_calloc() */
+static inline void dma_free(void *ptr, size_t size)
+{
+  system_heap_free(&i2s_out_heap_usage, ptr, size);
 }
 
 void init_dma_desc(struct dma_desc *head, unsigned count, uint8_t *buf, size_t size, size_t align, struct dma_desc *next)
@@ -89,6 +98,11 @@ int i2s_out_dma_init(struct i2s_out *i2s_out, size_t size, size_t align, unsigne
 
   LOG_DEBUG("size=%u align=%u repeat=%u -> desc_count=%u buf_size=%u", size, align, repeat, desc_count, buf_size);
 
+  // used for i2s_out_dma_free() on errors
+  i2s_out->dma_data_size = buf_size;
+  i2s_out->dma_data_count = desc_count;
+  i2s_out->dma_repeat_count = repeat;
+
   // allocate single word-aligned buffer
   if (!(i2s_out->dma_data_buf = dma_malloc(buf_size))) {
     LOG_ERROR("dma_malloc(dma_data_buf)");
@@ -124,9 +138,6 @@ int i2s_out_dma_init(struct i2s_out *i2s_out, size_t size, size_t align, unsigne
   }
   init_dma_desc(i2s_out->dma_end_desc, 1, i2s_out->dma_end_buf, DMA_END_BUF_SIZE, sizeof(uint32_t), NULL);
 
-  i2s_out->dma_data_count = desc_count;
-  i2s_out->dma_repeat_count = repeat;
-
   return 0;
 }
 
@@ -631,9 +642,9 @@ void i2s_out_dma_stop(struct i2s_out *i2s_out)
 
 void i2s_out_dma_free(struct i2s_out *i2s_out)
 {
-  free(i2s_out->dma_end_buf);
-  free(i2s_out->dma_data_buf);
-  free(i2s_out->dma_data_desc);
-  free(i2s_out->dma_repeat_desc);
-  free(i2s_out->dma_end_desc);
+  dma_free(i2s_out->dma_end_buf, DMA_END_BUF_SIZE);
+  dma_free(i2s_out->dma_data_buf, i2s_out->dma_data_size);
+  dma_free(i2s_out->dma_data_desc, i2s_out->dma_data_count * sizeof(*i2s_out->dma_data_desc));
+  dma_free(i2s_out->dma_repeat_desc, i2s_out->dma_data_count * i2s_out->dma_repeat_count * sizeof(*i2s_out->dma_repeat_desc));
+  dma_free(i2s_out->dma_end_desc, sizeof(*i2s_out->dma_end_desc));
 }
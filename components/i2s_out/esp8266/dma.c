@@ -9,6 +9,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <esp_heap_caps.h>
+#include <system_heap.h>
 
 #include <stdlib.h>
 #include <string.h>
@@ -25,16 +26,18 @@
 
 #define DMA_EOF_BUF_SIZE (DMA_DESC_SIZE_MIN)
 
+static struct system_heap_usage i2s_out_heap_usage = SYSTEM_HEAP_USAGE("i2s-out");
+
 /* Allocate memory from appropriate heap region for DMA */
 static inline void *dma_malloc(size_t size)
 {
-  return heap_caps_malloc(size, MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+  return system_heap_malloc(&i2s_out_heap_usage, SYSTEM_HEAP_DMA, size);
 }
 
 /* Allocate memory from appropriate heap region for DMA */
 static inline void *dma_calloc(size_t count, size_t size)
 {
-  return heap_caps_calloc(count, size, MALLOC_CAP_8BIT | MALLOC_CAP_DMA);
+  return system_heap_calloc(&i2s_out_heap_usage, SYSTEM_HEAP_DMA, count, size);
 }
 
 void init_dma_desc(struct dma_desc *head, unsigned count, uint8_t *buf, size_t size, size_t align, struct dma_desc *next)
@@ -221,6 +221,58 @@ error:
   return ret;
 }
 
+static int i2s_out_skip(struct i2s_out *i2s_out, size_t count, size_t size, TickType_t timeout)
+{
+  int ret = 0;
+
+  if (!xSemaphoreTakeRecursive(i2s_out->mutex, timeout)) {
+    LOG_ERROR("xSemaphoreTakeRecursive");
+    return -1;
+  }
+
+  if (!i2s_out->setup) {
+    LOG_ERROR("setup");
+    ret = -1;
+    goto error;
+  }
+
+  while (count) {
+    // get DMA buffer for remaining blocks
+    void *ptr;
+    size_t len;
+
+    if (!(len = i2s_out_dma_buffer(i2s_out, &ptr, count, size, timeout))) {
+      LOG_WARN("i2s_out_dma_buffer: DMA buffer full");
+      ret = 1;
+      goto error;
+    }
+
+    // keep existing data in DMA buffer
+    i2s_out_dma_commit(i2s_out, len, size);
+
+    count -= len;
+  }
+
+error:
+  if (!xSemaphoreGiveRecursive(i2s_out->mutex)) {
+    LOG_ERROR("xSemaphoreGiveRecursive");
+  }
+
+  return ret;
+}
+
+int i2s_out_skip_serial16(struct i2s_out *i2s_out, size_t count, TickType_t timeout)
+{
+  // i2s_out_write_serial16() uses single unaligned bytes
+  return i2s_out_skip(i2s_out, count * sizeof(uint16_t), 1, timeout);
+}
+
+int i2s_out_skip_serial32(struct i2s_out *i2s_out, size_t count, TickType_t timeout)
+{
+  // i2s_out_write_serial32() uses 32-bit blocks
+  return i2s_out_skip(i2s_out, count, sizeof(uint32_t), timeout);
+}
+
 #if I2S_OUT_PARALLEL_SUPPORTED
   int i2s_out_write_parallel8x8(struct i2s_out *i2s_out, uint8_t *data, unsigned width, TickType_t timeout)
   {
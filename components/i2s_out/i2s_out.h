@@ -60,6 +60,7 @@ struct i2s_out {
   struct dma_desc *dma_repeat_desc;
   struct dma_desc *dma_end_desc;
 
+  size_t dma_data_size;
   unsigned dma_data_count, dma_repeat_count;
   size_t dma_end_len;
 
@@ -178,6 +178,26 @@ int i2s_out_write_serial16(struct i2s_out *i2s_out, const uint16_t data[], size_
  */
 int i2s_out_write_serial32(struct i2s_out *i2s_out, const uint32_t *data, size_t count, TickType_t timeout);
 
+/**
+ * Skip over exactly `count` 16-bit words in the internal TX DMA buffer, leaving the data from a previous
+ * `i2s_out_write_serial16()` in place.
+ *
+ * This only works if each open() -> write -> start() cycle uses the same sequence of write/skip calls.
+ *
+ * Returns <0 error, 0 on success, >0 if TX buffer is full.
+ */
+int i2s_out_skip_serial16(struct i2s_out *i2s_out, size_t count, TickType_t timeout);
+
+/**
+ * Skip over exactly `count` 32-bit words in the internal TX DMA buffer, leaving the data from a previous
+ * `i2s_out_write_serial32()` in place.
+ *
+ * This only works if each open() -> write -> start() cycle uses the same sequence of write/skip calls.
+ *
+ * Returns <0 error, 0 on success, >0 if TX buffer is full.
+ */
+int i2s_out_skip_serial32(struct i2s_out *i2s_out, size_t count, TickType_t timeout);
+
 #if I2S_OUT_PARALLEL_SUPPORTED
   /**
    * Copy 8 channels of `width` x 8-bit `data` into the internal TX DMA buffer, transposing the buffers for
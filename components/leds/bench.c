@@ -0,0 +1,292 @@
+#include <leds.h>
+#include <leds_stats.h>
+#include "leds.h"
+
+#include <logging.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LEDS_BENCH_UNIVERSE_SIZE 512
+#define LEDS_BENCH_UNIVERSE_PIXELS (LEDS_BENCH_UNIVERSE_SIZE / 3) // 170
+
+/* Decode one universe of data per 170 pixels */
+static void leds_bench_format(struct leds *leds, enum leds_format format, const uint8_t *data)
+{
+  unsigned universe_pixels = leds_format_count(LEDS_BENCH_UNIVERSE_SIZE, format, 0);
+
+  if (universe_pixels > LEDS_BENCH_UNIVERSE_PIXELS) {
+    universe_pixels = LEDS_BENCH_UNIVERSE_PIXELS;
+  }
+
+  for (unsigned index = 0; index < leds->options.count; index += universe_pixels) {
+    struct leds_format_params params = {
+      .index = index,
+      .count = universe_pixels,
+    };
+
+    leds_set_format(leds, format, data, LEDS_BENCH_UNIVERSE_SIZE, params);
+  }
+}
+
+/* Reference kernels using per-byte access to each pixel */
+static void leds_bench_bytes_set(struct leds_color *pixels, unsigned count, struct leds_color color)
+{
+  for (unsigned i = 0; i < count; i++) {
+    pixels[i].r = color.r;
+    pixels[i].g = color.g;
+    pixels[i].b = color.b;
+    pixels[i].parameter = color.parameter;
+  }
+}
+
+static unsigned leds_bench_bytes_active(const struct leds_color *pixels, unsigned count, enum leds_parameter_type parameter_type)
+{
+  unsigned active = 0;
+
+  for (unsigned i = 0; i < count; i++) {
+    if (leds_color_active(pixels[i], parameter_type)) {
+      active++;
+    }
+  }
+
+  return active;
+}
+
+static unsigned leds_bench_bytes_power(const struct leds_color *pixels, unsigned count, enum leds_power_mode power_mode)
+{
+  unsigned power = 0;
+
+  for (unsigned i = 0; i < count; i++) {
+    switch (power_mode) {
+      case LEDS_POWER_NONE:
+        break;
+
+      case LEDS_POWER_RGB:
+        power += pixels[i].r + pixels[i].g + pixels[i].b;
+        break;
+
+      case LEDS_POWER_RGBA:
+        power += (pixels[i].r + pixels[i].g + pixels[i].b) * (pixels[i].dimmer >> 3);
+        break;
+
+      case LEDS_POWER_RGBW:
+        power += pixels[i].r + pixels[i].g + pixels[i].b + pixels[i].white;
+        break;
+
+      case LEDS_POWER_RGB2W:
+        power += pixels[i].r + pixels[i].g + pixels[i].b + (2 * pixels[i].white);
+        break;
+    }
+  }
+
+  return power;
+}
+
+/* Reference struct-of-arrays layout, with one byte plane per channel */
+struct leds_bench_planes {
+  uint8_t *r, *g, *b, *parameter;
+};
+
+static void leds_bench_planar_set(struct leds_bench_planes *planes, unsigned count, struct leds_color color)
+{
+  memset(planes->r, color.r, count);
+  memset(planes->g, color.g, count);
+  memset(planes->b, color.b, count);
+  memset(planes->parameter, color.parameter, count);
+}
+
+static unsigned leds_bench_planar_active(const struct leds_bench_planes *planes, unsigned count, enum leds_parameter_type parameter_type)
+{
+  unsigned active = 0;
+
+  switch (parameter_type) {
+    case LEDS_PARAMETER_NONE:
+      for (unsigned i = 0; i < count; i++) {
+        active += (planes->r[i] | planes->g[i] | planes->b[i]) ? 1 : 0;
+      }
+      break;
+
+    case LEDS_PARAMETER_DIMMER:
+      for (unsigned i = 0; i < count; i++) {
+        active += ((planes->r[i] | planes->g[i] | planes->b[i]) && planes->parameter[i]) ? 1 : 0;
+      }
+      break;
+
+    case LEDS_PARAMETER_WHITE:
+      for (unsigned i = 0; i < count; i++) {
+        active += (planes->r[i] | planes->g[i] | planes->b[i] | planes->parameter[i]) ? 1 : 0;
+      }
+      break;
+  }
+
+  return active;
+}
+
+static unsigned leds_bench_planar_power(const struct leds_bench_planes *planes, unsigned count, enum leds_power_mode power_mode)
+{
+  unsigned power = 0;
+
+  switch (power_mode) {
+    case LEDS_POWER_NONE:
+      break;
+
+    case LEDS_POWER_RGB:
+      for (unsigned i = 0; i < count; i++) {
+        power += planes->r[i] + planes->g[i] + planes->b[i];
+      }
+      break;
+
+    case LEDS_POWER_RGBA:
+      for (unsigned i = 0; i < count; i++) {
+        power += (planes->r[i] + planes->g[i] + planes->b[i]) * (planes->parameter[i] >> 3);
+      }
+      break;
+
+    case LEDS_POWER_RGBW:
+      for (unsigned i = 0; i < count; i++) {
+        power += planes->r[i] + planes->g[i] + planes->b[i] + planes->parameter[i];
+      }
+      break;
+
+    case LEDS_POWER_RGB2W:
+      for (unsigned i = 0; i < count; i++) {
+        power += planes->r[i] + planes->g[i] + planes->b[i] + (2 * planes->parameter[i]);
+      }
+      break;
+  }
+
+  return power;
+}
+
+int leds_bench(const struct leds_options *options, enum system_heap_placement placement, unsigned rounds, struct leds_bench_stats *stats)
+{
+  const struct leds_protocol_type *protocol_type;
+  struct leds_color *pixels;
+  struct leds_bench_planes planes;
+  uint8_t *plane_buf;
+  uint8_t *data;
+  volatile unsigned result;
+
+  if (options->protocol < LEDS_PROTOCOLS_COUNT && leds_protocol_types[options->protocol]) {
+    protocol_type = leds_protocol_types[options->protocol];
+  } else {
+    LOG_ERROR("invalid protocol=%d", options->protocol);
+    return -1;
+  }
+
+  if (!(pixels = system_heap_calloc(NULL, placement, options->count, sizeof(*pixels)))) {
+    LOG_ERROR("system_heap_calloc");
+    return -1;
+  }
+
+  if (!(plane_buf = system_heap_calloc(NULL, placement, 4, options->count))) {
+    LOG_ERROR("system_heap_calloc");
+    free(pixels);
+    return -1;
+  }
+
+  planes = (struct leds_bench_planes) {
+    .r          = plane_buf + 0 * options->count,
+    .g          = plane_buf + 1 * options->count,
+    .b          = plane_buf + 2 * options->count,
+    .parameter  = plane_buf + 3 * options->count,
+  };
+
+  if (!(data = malloc(LEDS_BENCH_UNIVERSE_SIZE))) {
+    LOG_ERROR("malloc");
+    free(plane_buf);
+    free(pixels);
+    return -1;
+  }
+
+  for (unsigned i = 0; i < LEDS_BENCH_UNIVERSE_SIZE; i++) {
+    data[i] = i;
+  }
+
+  // scratch leds for leds_set_format(), without any interface
+  struct leds leds = {
+    .options = *options,
+    .protocol_type = protocol_type,
+    .pixels = pixels,
+  };
+
+  stats_timer_init(&stats->set_all);
+  stats_timer_init(&stats->count_active);
+  stats_timer_init(&stats->count_power);
+  stats_timer_init(&stats->format_rgb);
+  stats_timer_init(&stats->format_grb);
+  stats_timer_init(&stats->format_rgbw);
+  stats_timer_init(&stats->set_all_bytes);
+  stats_timer_init(&stats->count_active_bytes);
+  stats_timer_init(&stats->count_power_bytes);
+  stats_timer_init(&stats->set_all_planar);
+  stats_timer_init(&stats->count_active_planar);
+  stats_timer_init(&stats->count_power_planar);
+
+  for (unsigned round = 0; round < rounds; round++) {
+    // vary the pixel values per round
+    struct leds_color color = {
+      .r = round,
+      .g = round >> 1,
+      .b = round >> 2,
+      .parameter = leds_parameter_default_for_type(protocol_type->parameter_type) ^ round,
+    };
+
+    WITH_STATS_TIMER(&stats->set_all) {
+      leds_colors_set(pixels, options->count, color);
+    }
+
+    WITH_STATS_TIMER(&stats->count_active) {
+      result = leds_colors_active(pixels, options->count, protocol_type->parameter_type);
+    }
+
+    WITH_STATS_TIMER(&stats->count_power) {
+      result = leds_power_total(pixels, 0, options->count, protocol_type->power_mode);
+    }
+
+    WITH_STATS_TIMER(&stats->format_rgb) {
+      leds_bench_format(&leds, LEDS_FORMAT_RGB, data);
+    }
+
+    WITH_STATS_TIMER(&stats->format_grb) {
+      leds_bench_format(&leds, LEDS_FORMAT_GRB, data);
+    }
+
+    WITH_STATS_TIMER(&stats->format_rgbw) {
+      leds_bench_format(&leds, LEDS_FORMAT_RGBW, data);
+    }
+
+    WITH_STATS_TIMER(&stats->set_all_bytes) {
+      leds_bench_bytes_set(pixels, options->count, color);
+    }
+
+    WITH_STATS_TIMER(&stats->count_active_bytes) {
+      result = leds_bench_bytes_active(pixels, options->count, protocol_type->parameter_type);
+    }
+
+    WITH_STATS_TIMER(&stats->count_power_bytes) {
+      result = leds_bench_bytes_power(pixels, options->count, protocol_type->power_mode);
+    }
+
+    WITH_STATS_TIMER(&stats->set_all_planar) {
+      leds_bench_planar_set(&planes, options->count, color);
+    }
+
+    WITH_STATS_TIMER(&stats->count_active_planar) {
+      result = leds_bench_planar_active(&planes, options->count, protocol_type->parameter_type);
+    }
+
+    WITH_STATS_TIMER(&stats->count_power_planar) {
+      result = leds_bench_planar_power(&planes, options->count, protocol_type->power_mode);
+    }
+  }
+
+  (void) result;
+
+  free(data);
+  free(plane_buf);
+  free(pixels);
+
+  return 0;
+}
@@ -1,4 +1,5 @@
 #include <leds.h>
+#include "leds.h"
 
 #include <logging.h>
 
@@ -37,12 +38,37 @@ bool leds_color_active (struct leds_color color, enum leds_parameter_type parame
   }
 }
 
-unsigned leds_colors_active (const struct leds_color *pixels, unsigned count, enum leds_parameter_type parameter_type)
+void leds_colors_set (struct leds_color *colors, unsigned count, struct leds_color color)
+{
+  // single 32-bit store per pixel
+  for (unsigned i = 0; i < count; i++) {
+    colors[i] = color;
+  }
+}
+
+/* Count pixels with any bits set within mask */
+static unsigned leds_colors_active_mask (const struct leds_color *colors, unsigned count, uint32_t mask)
+{
+  unsigned active = 0;
+
+  for (unsigned i = 0; i < count; i++) {
+    if (leds_color_word(colors[i]) & mask) {
+      active++;
+    }
+  }
+
+  return active;
+}
+
+/* Count pixels with any of the RGB bits set, and any of the dimmer bits set */
+static unsigned leds_colors_active_dimmer (const struct leds_color *colors, unsigned count)
 {
   unsigned active = 0;
 
   for (unsigned i = 0; i < count; i++) {
-    if (leds_color_active(pixels[i], parameter_type)) {
+    uint32_t word = leds_color_word(colors[i]);
+
+    if ((word & LEDS_COLOR_WORD_RGB) && (word & LEDS_COLOR_WORD_PARAMETER)) {
       active++;
     }
   }
@@ -50,6 +76,23 @@ unsigned leds_colors_active (const struct leds_color *pixels, unsigned count, en
   return active;
 }
 
+unsigned leds_colors_active (const struct leds_color *colors, unsigned count, enum leds_parameter_type parameter_type)
+{
+  switch (parameter_type) {
+    case LEDS_PARAMETER_NONE:
+      return leds_colors_active_mask(colors, count, LEDS_COLOR_WORD_RGB);
+
+    case LEDS_PARAMETER_DIMMER:
+      return leds_colors_active_dimmer(colors, count);
+
+    case LEDS_PARAMETER_WHITE:
+      return leds_colors_active_mask(colors, count, LEDS_COLOR_WORD_RGB | LEDS_COLOR_WORD_PARAMETER);
+
+    default:
+      LOG_FATAL("invalid parameter_type=%u", parameter_type);
+  }
+}
+
 struct leds_color leds_color_intensity (struct leds_color color, enum leds_parameter_type parameter_type, uint8_t intensity)
 {
   switch (parameter_type) {
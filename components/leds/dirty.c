@@ -0,0 +1,68 @@
+#include "dirty.h"
+
+#include <string.h>
+
+static void leds_dirty_merge_closest(struct leds_dirty *dirty)
+{
+  unsigned merge = 0;
+
+  // find the pair of ranges with the smallest gap between them
+  for (unsigned i = 1; i + 1 < dirty->count; i++) {
+    unsigned gap = dirty->ranges[i + 1].start - dirty->ranges[i].end;
+
+    if (gap < dirty->ranges[merge + 1].start - dirty->ranges[merge].end) {
+      merge = i;
+    }
+  }
+
+  dirty->ranges[merge].end = dirty->ranges[merge + 1].end;
+
+  memmove(&dirty->ranges[merge + 1], &dirty->ranges[merge + 2], (dirty->count - merge - 2) * sizeof(*dirty->ranges));
+
+  dirty->count--;
+}
+
+void leds_dirty_mark(struct leds_dirty *dirty, unsigned start, unsigned end)
+{
+  unsigned i, j;
+
+  if (start >= end) {
+    return;
+  }
+
+  // skip any ranges ending before start
+  for (i = 0; i < dirty->count && dirty->ranges[i].end < start; i++) {
+
+  }
+
+  // extend over any ranges overlapping or adjacent to [start, end)
+  for (j = i; j < dirty->count && dirty->ranges[j].start <= end; j++) {
+    if (dirty->ranges[j].start < start) {
+      start = dirty->ranges[j].start;
+    }
+
+    if (dirty->ranges[j].end > end) {
+      end = dirty->ranges[j].end;
+    }
+  }
+
+  if (j > i) {
+    // replace ranges [i, j) with the merged range
+    dirty->ranges[i] = (struct leds_dirty_range) { start, end };
+
+    memmove(&dirty->ranges[i + 1], &dirty->ranges[j], (dirty->count - j) * sizeof(*dirty->ranges));
+
+    dirty->count -= (j - i - 1);
+
+  } else {
+    // insert new range before i
+    memmove(&dirty->ranges[i + 1], &dirty->ranges[i], (dirty->count - i) * sizeof(*dirty->ranges));
+
+    dirty->ranges[i] = (struct leds_dirty_range) { start, end };
+    dirty->count++;
+
+    if (dirty->count > LEDS_DIRTY_RANGES_MAX) {
+      leds_dirty_merge_closest(dirty);
+    }
+  }
+}
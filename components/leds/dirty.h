@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdbool.h>
+
+// maximum number of separate dirty ranges to track before merging the closest ranges
+#define LEDS_DIRTY_RANGES_MAX 8
+
+/* Range of LED indexes [start, end) */
+struct leds_dirty_range {
+  unsigned start, end;
+};
+
+/* Track changed LED indexes since the last leds_tx(), as a sorted set of non-overlapping ranges */
+struct leds_dirty {
+  unsigned count;
+
+  // one extra slot for merging
+  struct leds_dirty_range ranges[LEDS_DIRTY_RANGES_MAX + 1];
+};
+
+static inline void leds_dirty_clear(struct leds_dirty *dirty)
+{
+  dirty->count = 0;
+}
+
+static inline bool leds_dirty_empty(const struct leds_dirty *dirty)
+{
+  return dirty->count == 0;
+}
+
+/* Mark LEDs [start, end) as dirty, merging with any overlapping or adjacent ranges */
+void leds_dirty_mark(struct leds_dirty *dirty, unsigned start, unsigned end);
+
+/*
+ * Return the next dirty range containing or following index, limited to count.
+ *
+ * Returns an empty [count, count) range if there are no more dirty LEDs.
+ * Returns [index, count) for a NULL dirty, treating all LEDs as dirty.
+ */
+static inline struct leds_dirty_range leds_dirty_next(const struct leds_dirty *dirty, unsigned index, unsigned count)
+{
+  if (!dirty) {
+    return (struct leds_dirty_range) { index, count };
+  }
+
+  for (unsigned i = 0; i < dirty->count; i++) {
+    struct leds_dirty_range range = dirty->ranges[i];
+
+    if (range.end <= index) {
+      continue;
+    }
+
+    if (range.start < index) {
+      range.start = index;
+    }
+
+    if (range.start > count) {
+      range.start = count;
+    }
+
+    if (range.end > count) {
+      range.end = count;
+    }
+
+    return range;
+  }
+
+  return (struct leds_dirty_range) { count, count };
+}
@@ -2,6 +2,9 @@
 
 #include <logging.h>
 
+#include <stdint.h>
+#include <string.h>
+
 unsigned leds_format_count(size_t len, enum leds_format format, unsigned group)
 {
   if (!group) {
@@ -41,12 +44,102 @@ static inline void set_leds_pixels(struct leds *leds, unsigned i, struct leds_fo
   }
 }
 
+/* Return number of whole pixels of size bytes in len, up to count */
+static inline unsigned decode_count(size_t len, unsigned size, unsigned count)
+{
+  unsigned len_count = len / size;
+
+  return len_count < count ? len_count : count;
+}
+
+static inline bool decode_aligned(const uint8_t *data)
+{
+  return ((uintptr_t) data & 3) == 0;
+}
+
+/*
+ * Decoders for the common segment=1 case, writing directly to consecutive pixels.
+ *
+ * The count must already be bounded by the data len.
+ */
+static void decode_rgb(struct leds_color *pixels, const uint8_t *data, unsigned count, uint8_t parameter)
+{
+  uint32_t p = (uint32_t) parameter << 24;
+  unsigned i = 0;
+
+  // stride of 3 bytes is word-aligned after at most 3 pixels
+  for (; i < count && !decode_aligned(data); i++, data += 3) {
+    pixels[i] = (struct leds_color) { .r = data[0], .g = data[1], .b = data[2], .parameter = parameter };
+  }
+
+  // unpack 4 pixels from 3 words: RGBR GBRG BRGB
+  for (; i + 4 <= count; i += 4, data += 12) {
+    uint32_t w[3];
+
+    memcpy(w, __builtin_assume_aligned(data, 4), sizeof(w));
+
+    pixels[i + 0] = (union leds_color_word) { .word = (w[0] & LEDS_COLOR_WORD_RGB) | p }.color;
+    pixels[i + 1] = (union leds_color_word) { .word = (w[0] >> 24) | ((w[1] << 8) & LEDS_COLOR_WORD_RGB) | p }.color;
+    pixels[i + 2] = (union leds_color_word) { .word = (w[1] >> 16) | ((w[2] << 16) & LEDS_COLOR_WORD_RGB) | p }.color;
+    pixels[i + 3] = (union leds_color_word) { .word = (w[2] >> 8) | p }.color;
+  }
+
+  for (; i < count; i++, data += 3) {
+    pixels[i] = (struct leds_color) { .r = data[0], .g = data[1], .b = data[2], .parameter = parameter };
+  }
+}
+
+static void decode_bgr(struct leds_color *pixels, const uint8_t *data, unsigned count, uint8_t parameter)
+{
+  for (unsigned i = 0; i < count; i++, data += 3) {
+    pixels[i] = (struct leds_color) { .b = data[0], .g = data[1], .r = data[2], .parameter = parameter };
+  }
+}
+
+static void decode_grb(struct leds_color *pixels, const uint8_t *data, unsigned count, uint8_t parameter)
+{
+  for (unsigned i = 0; i < count; i++, data += 3) {
+    pixels[i] = (struct leds_color) { .g = data[0], .r = data[1], .b = data[2], .parameter = parameter };
+  }
+}
+
+/* RGB + ignored 4th byte, replaced with parameter */
+static void decode_rgbx(struct leds_color *pixels, const uint8_t *data, unsigned count, uint8_t parameter)
+{
+  uint32_t p = (uint32_t) parameter << 24;
+
+  if (decode_aligned(data)) {
+    for (unsigned i = 0; i < count; i++, data += 4) {
+      uint32_t w;
+
+      memcpy(&w, __builtin_assume_aligned(data, 4), sizeof(w));
+
+      pixels[i] = (union leds_color_word) { .word = (w & LEDS_COLOR_WORD_RGB) | p }.color;
+    }
+  } else {
+    for (unsigned i = 0; i < count; i++, data += 4) {
+      pixels[i] = (struct leds_color) { .r = data[0], .g = data[1], .b = data[2], .parameter = parameter };
+    }
+  }
+}
+
+/* RGB + parameter, matching the struct leds_color layout */
+static void decode_rgbp(struct leds_color *pixels, const uint8_t *data, unsigned count)
+{
+  memcpy(pixels, data, count * sizeof(*pixels));
+}
+
 void leds_set_format_rgb(struct leds *leds, const uint8_t *data, size_t len, struct leds_format_params params)
 {
   uint8_t parameter = leds_parameter_default(leds);
 
   LOG_DEBUG("len=%u index=%u count=%u segment=%u", len, params.index, params.count, params.segment);
 
+  if (params.segment == 1) {
+    decode_rgb(leds->pixels + params.index, data, decode_count(len, 3, params.count), parameter);
+    return;
+  }
+
   for (unsigned i = 0; i < params.count && len >= (i + 1) * 3; i++) {
     set_leds_pixels(leds, i, params, (struct leds_color) {
       .r = data[i * 3 + 0],
@@ -64,6 +157,11 @@ void leds_set_format_bgr(struct leds *leds, const uint8_t *data, size_t len, str
 
   LOG_DEBUG("len=%u index=%u count=%u segment=%u", len, params.index, params.count, params.segment);
 
+  if (params.segment == 1) {
+    decode_bgr(leds->pixels + params.index, data, decode_count(len, 3, params.count), parameter);
+    return;
+  }
+
   for (unsigned i = 0; i < params.count && len >= (i + 1) * 3; i++) {
     set_leds_pixels(leds, i, params, (struct leds_color) {
       .b = data[i * 3 + 0],
@@ -81,6 +179,11 @@ void leds_set_format_grb(struct leds *leds, const uint8_t *data, size_t len, str
 
   LOG_DEBUG("len=%u index=%u count=%u segment=%u", len, params.index, params.count, params.segment);
 
+  if (params.segment == 1) {
+    decode_grb(leds->pixels + params.index, data, decode_count(len, 3, params.count), parameter);
+    return;
+  }
+
   for (unsigned i = 0; i < params.count && len >= (i + 1) * 3; i++) {
     set_leds_pixels(leds, i, params, (struct leds_color) {
       .g = data[i * 3 + 0],
@@ -99,6 +202,18 @@ void leds_set_format_rgba(struct leds *leds, const uint8_t *data, size_t len, st
 
   LOG_DEBUG("len=%u index=%u count=%u segment=%u", len, params.index, params.count, params.segment);
 
+  if (params.segment == 1) {
+    unsigned count = decode_count(len, 4, params.count);
+
+    if (parameter == LEDS_PARAMETER_DIMMER) {
+      decode_rgbp(leds->pixels + params.index, data, count);
+    } else {
+      decode_rgbx(leds->pixels + params.index, data, count, parameter_default);
+    }
+
+    return;
+  }
+
   for (unsigned i = 0; i < params.count && len >= (i + 1) * 4; i++) {
     set_leds_pixels(leds, i, params, (struct leds_color) {
       .r = data[i * 4 + 0],
@@ -117,6 +232,18 @@ void leds_set_format_rgbw(struct leds *leds, const uint8_t *data, size_t len, st
 
   LOG_DEBUG("len=%u index=%u count=%u segment=%u", len, params.index, params.count, params.segment);
 
+  if (params.segment == 1) {
+    unsigned count = decode_count(len, 4, params.count);
+
+    if (parameter == LEDS_PARAMETER_WHITE) {
+      decode_rgbp(leds->pixels + params.index, data, count);
+    } else {
+      decode_rgbx(leds->pixels + params.index, data, count, parameter_default);
+    }
+
+    return;
+  }
+
   for (unsigned i = 0; i < params.count && len >= (i + 1) * 4; i++) {
     set_leds_pixels(leds, i, params, (struct leds_color) {
       .r = data[i * 4 + 0],
@@ -292,6 +419,7 @@ int leds_set_format(struct leds *leds, enum leds_format format, const void *data
   }
 
   leds->pixels_limit_dirty = true;
+  leds_dirty_mark(&leds->pixels_dirty, params.index, params.index + params.count * params.segment);
 
   switch(format) {
     case LEDS_FORMAT_RGB:
@@ -345,7 +345,8 @@ enum leds_power_mode {
 
 enum leds_power_mode leds_power_mode_for_protocol(enum leds_protocol protocol);
 
-struct leds_color {
+// word-aligned, to allow loading/storing a pixel as a single 32-bit word
+struct __attribute__((aligned(4))) leds_color {
   uint8_t r, g, b;
 
   union {
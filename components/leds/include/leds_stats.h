@@ -2,6 +2,7 @@
 
 #include <leds.h>
 #include <stats.h>
+#include <system_heap.h>
 
 #include <sdkconfig.h>
 
@@ -11,6 +12,9 @@ struct leds_interface_i2s_stats {
   struct stats_timer write;
   struct stats_timer start;
   struct stats_timer flush;
+
+  // bytes encoded per frame
+  struct stats_gauge encode;
 };
 #endif
 
@@ -19,12 +23,27 @@ struct leds_interface_stats {
   struct leds_interface_spi_stats {
     struct stats_timer open;
     struct stats_timer tx;
+
+    // bytes encoded per frame
+    struct stats_gauge encode;
+
+  #if CONFIG_LEDS_SPI_INTR_WRITE_ENABLED
+    // achieved/configured kbit/s per frame
+    struct stats_gauge throughput;
+    struct stats_gauge clock;
+  #endif
   } spi;
 #endif
 #if CONFIG_LEDS_UART_ENABLED
   struct leds_interface_uart_stats {
     struct stats_timer open;
     struct stats_timer tx;
+
+    // bytes encoded per frame
+    struct stats_gauge encode;
+
+    // pixels/s written per frame, including reset
+    struct stats_gauge pixel_rate;
   } uart;
 #endif
 #if LEDS_I2S_INTERFACE_COUNT > 0
@@ -44,3 +63,34 @@ void leds_reset_interface_stats();
  * Get a copy of the global per-interface stats.
  */
 void leds_get_interface_stats(struct leds_interface_stats *stats);
+
+struct leds_bench_stats {
+  struct stats_timer set_all;
+  struct stats_timer count_active;
+  struct stats_timer count_power;
+
+  // decode all pixels, as 170-pixel DMX universes
+  struct stats_timer format_rgb;
+  struct stats_timer format_grb;
+  struct stats_timer format_rgbw;
+
+  // reference per-byte loops, as used before the 32-bit word kernels
+  struct stats_timer set_all_bytes;
+  struct stats_timer count_active_bytes;
+  struct stats_timer count_power_bytes;
+
+  // reference struct-of-arrays layout, using one plane per channel
+  struct stats_timer set_all_planar;
+  struct stats_timer count_active_planar;
+  struct stats_timer count_power_planar;
+};
+
+/*
+ * Benchmark the per-pixel kernels, using a scratch pixel buffer for the given protocol/count options.
+ *
+ * The scratch pixel buffer is allocated using the given placement, to compare internal/external RAM.
+ * The word kernels are compared against reference per-byte and struct-of-arrays kernels.
+ *
+ * Does not touch any leds outputs. Each timer is updated once per round.
+ */
+int leds_bench(const struct leds_options *options, enum system_heap_placement placement, unsigned rounds, struct leds_bench_stats *stats);
@@ -19,7 +19,7 @@ int leds_interface_init(union leds_interface_state *interface, const struct leds
         LOG_ERROR("unsupported interface=SPI for protocol=%d", options->protocol);
         return -1;
 
-      } else if ((err = leds_interface_spi_init(&interface->spi, &options->spi, protocol_type->spi_interface_mode, protocol_type->spi_interface_func))) {
+      } else if ((err = leds_interface_spi_init(&interface->spi, &options->spi, protocol_type->spi_interface_mode, protocol_type->spi_interface_func, options->count))) {
         LOG_ERROR("leds_interface_spi_init");
         return err;
       }
@@ -141,7 +141,7 @@ int leds_interface_tx(struct leds *leds)
 
   #if CONFIG_LEDS_SPI_ENABLED
     case LEDS_INTERFACE_SPI:
-      return leds_interface_spi_tx(&leds->interface.spi, leds->pixels, leds->options.count, &leds->limit);
+      return leds_interface_spi_tx(&leds->interface.spi, leds->pixels, leds->options.count, &leds->limit, &leds->pixels_dirty);
   #endif
 
   #if CONFIG_LEDS_UART_ENABLED
@@ -156,7 +156,7 @@ int leds_interface_tx(struct leds *leds)
   # if LEDS_I2S_INTERFACE_COUNT > 1
     case LEDS_INTERFACE_I2S1:
   # endif
-    return leds_interface_i2s_tx(&leds->interface.i2s, leds->pixels, leds->options.count, &leds->limit);
+    return leds_interface_i2s_tx(&leds->interface.i2s, leds->pixels, leds->options.count, &leds->limit, &leds->pixels_dirty);
   #endif
 
     default:
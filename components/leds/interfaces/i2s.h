@@ -2,6 +2,7 @@
 
 #include <leds.h>
 
+#include "../dirty.h"
 #include "../limit.h"
 
 #if CONFIG_LEDS_I2S_ENABLED
@@ -62,6 +63,9 @@ struct leds_interface_i2s {
   struct i2s_out *i2s_out;
   struct i2s_out_options i2s_out_options;
   bool i2s_out_setup;
+  bool i2s_out_valid; // DMA buffer contains a complete frame from a previous tx with persistent setup
+
+  size_t encode_size; // bytes encoded for current tx
   
   struct leds_interface_options_gpio gpio;
   struct leds_interface_i2s_stats *stats;
@@ -72,7 +76,7 @@ size_t leds_interface_i2s_buffer_align(enum leds_interface_i2s_mode mode, unsign
 
 int leds_interface_i2s_init(struct leds_interface_i2s *interface, const struct leds_interface_i2s_options *options, enum leds_interface_i2s_mode mode, union leds_interface_i2s_func func, unsigned count, struct leds_interface_i2s_stats *stats);
 int leds_interface_i2s_setup(struct leds_interface_i2s *interface);
-int leds_interface_i2s_tx(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit);
+int leds_interface_i2s_tx(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty);
 int leds_interface_i2s_close(struct leds_interface_i2s *interface);
 int leds_interface_i2s_reset(struct leds_interface_i2s *interface);
 
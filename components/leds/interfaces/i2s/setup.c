@@ -17,8 +17,9 @@ int leds_interface_i2s_init(struct leds_interface_i2s *interface, const struct l
   interface->parallel = 0;
 #endif
 
-  if (!(interface->buf = calloc(1, leds_interface_i2s_buf_size(interface->mode, interface->parallel)))) {
-    LOG_ERROR("calloc");
+  // encode bounce buffer between external pixel state and the internal DMA buffers
+  if (!(interface->buf = system_heap_calloc(&leds_heap_usage, SYSTEM_HEAP_INTERNAL, 1, leds_interface_i2s_buf_size(interface->mode, interface->parallel)))) {
+    LOG_ERROR("system_heap_calloc");
     return -1;
   }
 
@@ -158,6 +159,7 @@ int leds_interface_i2s_setup(struct leds_interface_i2s *interface)
   }
 
   interface->i2s_out_setup = true;
+  interface->i2s_out_valid = false;
 
 #if CONFIG_LEDS_GPIO_ENABLED
   leds_gpio_setup(&interface->gpio);
@@ -171,6 +173,7 @@ int leds_interface_i2s_close(struct leds_interface_i2s *interface)
   int err = 0;
 
   interface->i2s_out_setup = false;
+  interface->i2s_out_valid = false;
 
 #if CONFIG_LEDS_GPIO_ENABLED
   leds_gpio_close(&interface->gpio);
@@ -188,6 +191,8 @@ int leds_interface_i2s_reset(struct leds_interface_i2s *interface)
 {
   int err = 0;
 
+  interface->i2s_out_valid = false;
+
 #if CONFIG_LEDS_GPIO_ENABLED
   leds_gpio_close(&interface->gpio);
 #endif
@@ -4,7 +4,7 @@
 
 #include <logging.h>
 
-static int leds_interface_i2s_tx_32bit_bck_serial32(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit)
+static int leds_interface_i2s_tx_32bit_bck_serial32(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty)
 {
   int err;
 
@@ -17,54 +17,91 @@ static int leds_interface_i2s_tx_32bit_bck_serial32(struct leds_interface_i2s *i
   }
 
   // pixel frames
-  for (unsigned i = 0; i < count; i++) {
-    // 32-bit pixel data
-    interface->func.i2s_mode_32bit(interface->buf->i2s_mode_32bit, pixels, i, limit);
+  for (unsigned i = 0; i < count; ) {
+    struct leds_dirty_range range = leds_dirty_next(dirty, i, count);
 
-    if ((err = i2s_out_write_serial32(interface->i2s_out, interface->buf->i2s_mode_32bit, 1, interface->options->timeout))) {
-      LOG_ERROR("i2s_out_write_serial32");
+    // keep unchanged pixels
+    if (range.start > i && (err = i2s_out_skip_serial32(interface->i2s_out, range.start - i, interface->options->timeout))) {
+      LOG_ERROR("i2s_out_skip_serial32");
       return err;
     }
+
+    for (i = range.start; i < range.end; i++) {
+      // 32-bit pixel data
+      interface->func.i2s_mode_32bit(interface->buf->i2s_mode_32bit, pixels, i, limit);
+
+      if ((err = i2s_out_write_serial32(interface->i2s_out, interface->buf->i2s_mode_32bit, 1, interface->options->timeout))) {
+        LOG_ERROR("i2s_out_write_serial32");
+        return err;
+      }
+    }
+
+    interface->encode_size += (range.end - range.start) * sizeof(interface->buf->i2s_mode_32bit);
   }
 
   return 0;
 }
 
-static int leds_interface_i2s_tx_24bit_4x4_serial16(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit)
+static int leds_interface_i2s_tx_24bit_4x4_serial16(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty)
 {
   int err;
 
-  for (unsigned i = 0; i < count; i++) {
-    // 6x16-bit pixel data
-    interface->func.i2s_mode_24bit_4x4(interface->buf->i2s_mode_24bit_4x4, pixels, i, limit);
+  for (unsigned i = 0; i < count; ) {
+    struct leds_dirty_range range = leds_dirty_next(dirty, i, count);
 
-    if ((err = i2s_out_write_serial16(interface->i2s_out, interface->buf->i2s_mode_24bit_4x4, 6, interface->options->timeout))) {
-      LOG_ERROR("i2s_out_write_serial16");
+    // keep unchanged pixels
+    if (range.start > i && (err = i2s_out_skip_serial16(interface->i2s_out, (range.start - i) * 6, interface->options->timeout))) {
+      LOG_ERROR("i2s_out_skip_serial16");
       return err;
     }
+
+    for (i = range.start; i < range.end; i++) {
+      // 6x16-bit pixel data
+      interface->func.i2s_mode_24bit_4x4(interface->buf->i2s_mode_24bit_4x4, pixels, i, limit);
+
+      if ((err = i2s_out_write_serial16(interface->i2s_out, interface->buf->i2s_mode_24bit_4x4, 6, interface->options->timeout))) {
+        LOG_ERROR("i2s_out_write_serial16");
+        return err;
+      }
+    }
+
+    interface->encode_size += (range.end - range.start) * sizeof(interface->buf->i2s_mode_24bit_4x4);
   }
 
   return 0;
 }
 
-static int leds_interface_i2s_tx_32bit_4x4_serial16(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit)
+static int leds_interface_i2s_tx_32bit_4x4_serial16(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty)
 {
   int err;
 
-  for (unsigned i = 0; i < count; i++) {
-    // 8x16-bit pixel data
-    interface->func.i2s_mode_32bit_4x4(interface->buf->i2s_mode_32bit_4x4, pixels, i, limit);
+  for (unsigned i = 0; i < count; ) {
+    struct leds_dirty_range range = leds_dirty_next(dirty, i, count);
 
-    if ((err = i2s_out_write_serial16(interface->i2s_out, interface->buf->i2s_mode_32bit_4x4, 8, interface->options->timeout))) {
-      LOG_ERROR("i2s_out_write_serial16");
+    // keep unchanged pixels
+    if (range.start > i && (err = i2s_out_skip_serial16(interface->i2s_out, (range.start - i) * 8, interface->options->timeout))) {
+      LOG_ERROR("i2s_out_skip_serial16");
       return err;
     }
+
+    for (i = range.start; i < range.end; i++) {
+      // 8x16-bit pixel data
+      interface->func.i2s_mode_32bit_4x4(interface->buf->i2s_mode_32bit_4x4, pixels, i, limit);
+
+      if ((err = i2s_out_write_serial16(interface->i2s_out, interface->buf->i2s_mode_32bit_4x4, 8, interface->options->timeout))) {
+        LOG_ERROR("i2s_out_write_serial16");
+        return err;
+      }
+    }
+
+    interface->encode_size += (range.end - range.start) * sizeof(interface->buf->i2s_mode_32bit_4x4);
   }
 
   return 0;
 }
 
 #if I2S_OUT_PARALLEL_SUPPORTED
+  // parallel modes transpose pixels from each output into shared DMA words, and always encode the full frame
   static int leds_interface_i2s_tx_32bit_bck_parallel8(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit)
   {
     unsigned length = count / interface->parallel;
@@ -90,6 +127,8 @@ static int leds_interface_i2s_tx_32bit_4x4_serial16(struct leds_interface_i2s *i
       }
     }
 
+    interface->encode_size += length * sizeof(interface->buf->i2s_mode_32bit_parallel8);
+
     return 0;
   }
 
@@ -110,6 +149,8 @@ static int leds_interface_i2s_tx_32bit_4x4_serial16(struct leds_interface_i2s *i
       }
     }
 
+    interface->encode_size += length * sizeof(interface->buf->i2s_mode_24bit_4x4_parallel8);
+
     return 0;
   }
 
@@ -130,11 +171,13 @@ static int leds_interface_i2s_tx_32bit_4x4_serial16(struct leds_interface_i2s *i
       }
     }
 
+    interface->encode_size += length * sizeof(interface->buf->i2s_mode_32bit_4x4_parallel8);
+
     return 0;
   }
 #endif
 
-static int leds_interface_i2s_tx_write(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit)
+static int leds_interface_i2s_tx_write(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty)
 {
   switch(interface->mode) {
     case LEDS_INTERFACE_I2S_MODE_32BIT_BCK:
@@ -142,10 +185,10 @@ static int leds_interface_i2s_tx_write(struct leds_interface_i2s *interface, con
       if (interface->parallel) {
         return leds_interface_i2s_tx_32bit_bck_parallel8(interface, pixels, count, limit);
       } else {
-        return leds_interface_i2s_tx_32bit_bck_serial32(interface, pixels, count, limit);
+        return leds_interface_i2s_tx_32bit_bck_serial32(interface, pixels, count, limit, dirty);
       }
     #else
-      return leds_interface_i2s_tx_32bit_bck_serial32(interface, pixels, count, limit);
+      return leds_interface_i2s_tx_32bit_bck_serial32(interface, pixels, count, limit, dirty);
     #endif
 
     case LEDS_INTERFACE_I2S_MODE_24BIT_1U200_4X4_80UL:
@@ -154,10 +197,10 @@ static int leds_interface_i2s_tx_write(struct leds_interface_i2s *interface, con
       if (interface->parallel) {
         return leds_interface_i2s_tx_24bit_4x4_parallel8(interface, pixels, count, limit);
       } else {
-        return leds_interface_i2s_tx_24bit_4x4_serial16(interface, pixels, count, limit);
+        return leds_interface_i2s_tx_24bit_4x4_serial16(interface, pixels, count, limit, dirty);
       }
     #else
-      return leds_interface_i2s_tx_24bit_4x4_serial16(interface, pixels, count, limit);
+      return leds_interface_i2s_tx_24bit_4x4_serial16(interface, pixels, count, limit, dirty);
     #endif
 
     case LEDS_INTERFACE_I2S_MODE_32BIT_1U250_4X4_80UL:
@@ -165,10 +208,10 @@ static int leds_interface_i2s_tx_write(struct leds_interface_i2s *interface, con
       if (interface->parallel) {
         return leds_interface_i2s_tx_32bit_4x4_parallel8(interface, pixels, count, limit);
       } else {
-        return leds_interface_i2s_tx_32bit_4x4_serial16(interface, pixels, count, limit);
+        return leds_interface_i2s_tx_32bit_4x4_serial16(interface, pixels, count, limit, dirty);
       }
     #else
-      return leds_interface_i2s_tx_32bit_4x4_serial16(interface, pixels, count, limit);
+      return leds_interface_i2s_tx_32bit_4x4_serial16(interface, pixels, count, limit, dirty);
     #endif
 
     default:
@@ -177,7 +220,7 @@ static int leds_interface_i2s_tx_write(struct leds_interface_i2s *interface, con
 }
 
 
-int leds_interface_i2s_tx(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit)
+int leds_interface_i2s_tx(struct leds_interface_i2s *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty)
 {
   bool setup = interface->i2s_out_setup; // sync setup() -> write -> flush -> close()?
   int err = 0;
@@ -189,12 +232,27 @@ int leds_interface_i2s_tx(struct leds_interface_i2s *interface, const struct led
     }
   }
 
+  if (!setup || !interface->i2s_out_valid) {
+    // DMA buffer may contain data from a different leds instance, re-encode all pixels
+    dirty = NULL;
+  }
+
+  interface->encode_size = 0;
+
   WITH_STATS_TIMER(&interface->stats->write) {
-    if ((err = leds_interface_i2s_tx_write(interface, pixels, count, limit))) {
+    if ((err = leds_interface_i2s_tx_write(interface, pixels, count, limit, dirty))) {
+      // DMA buffer contents are undefined
+      interface->i2s_out_valid = false;
+
       goto error;
     }
   }
 
+  // only a persistent setup retains the DMA buffer for the next tx
+  interface->i2s_out_valid = setup;
+
+  stats_gauge_sample(&interface->stats->encode, interface->encode_size);
+
   if (!setup) {
     // sync, wait for done before close
     WITH_STATS_TIMER(&interface->stats->flush) {
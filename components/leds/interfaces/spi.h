@@ -2,6 +2,7 @@
 
 #include <leds.h>
 
+#include "../dirty.h"
 #include "../limit.h"
 
 #if CONFIG_LEDS_SPI_ENABLED
@@ -10,7 +11,13 @@
     #include <spi_master.h>
 
     #define LEDS_INTERFACE_SPI_MIN_SIZE (SPI_WRITE_MAX)
-    #define LEDS_INTERFACE_SPI_MAX_SIZE (SPI_WRITE_MAX)
+
+    #if CONFIG_LEDS_SPI_INTR_WRITE_ENABLED
+      // complete frames, written from ISR
+      #define LEDS_INTERFACE_SPI_MAX_SIZE (4096)
+    #else
+      #define LEDS_INTERFACE_SPI_MAX_SIZE (SPI_WRITE_MAX)
+    #endif
 
   #else
     // using esp-idf spi_master driver
@@ -57,6 +64,8 @@
     union leds_interface_spi_buf buf;
 
     size_t buf_size;
+    bool buf_frame; // buf fits a complete frame, and is only written once per tx
+    bool buf_valid; // buf_frame contains a complete frame from a previous tx
 
   #if CONFIG_IDF_TARGET_ESP8266
     struct spi_master *spi_master;
@@ -68,8 +77,14 @@
     struct leds_interface_options_gpio gpio;
   };
 
+  /* Size of single frame */
+  size_t leds_interface_spi_buf_size(enum leds_interface_spi_mode mode);
+
+  /* Number of frames for count LEDs, including start/end frames */
+  unsigned leds_interface_spi_buf_count(enum leds_interface_spi_mode mode, unsigned count);
+
   size_t leds_interface_spi_buffer_size(enum leds_interface_spi_mode mode, unsigned count);
 
-  int leds_interface_spi_init(struct leds_interface_spi *interface, const struct leds_interface_spi_options *options, enum leds_interface_spi_mode mode, union leds_interface_spi_func func);
-  int leds_interface_spi_tx(struct leds_interface_spi *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit);
+  int leds_interface_spi_init(struct leds_interface_spi *interface, const struct leds_interface_spi_options *options, enum leds_interface_spi_mode mode, union leds_interface_spi_func func, unsigned count);
+  int leds_interface_spi_tx(struct leds_interface_spi *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty);
 #endif
@@ -37,8 +37,8 @@
       .clock  = options->clock,
     };
 
-    if (!(interface->buf.p = malloc(interface->buf_size))) {
-      LOG_ERROR("malloc");
+    if (!(interface->buf.p = system_heap_malloc(&leds_heap_usage, SYSTEM_HEAP_INTERNAL, interface->buf_size))) {
+      LOG_ERROR("system_heap_malloc(%u)", interface->buf_size);
       return -1;
     }
 
@@ -50,25 +50,63 @@
     return spi_master_open(interface->spi_master, interface->spi_write_options);
   }
 
-  static int leds_interface_spi_master_write(struct leds_interface_spi *interface, size_t len)
-  {
-    uint8_t *buf = interface->buf.u8;
-    int ret;
+  #if CONFIG_LEDS_SPI_INTR_WRITE_ENABLED
+    static void leds_interface_spi_master_stats(struct leds_interface_spi *interface)
+    {
+      struct leds_interface_spi_stats *stats = &leds_interface_stats.spi;
+      size_t len;
+      unsigned us;
 
-    while (len) {
-      if ((ret = spi_master_write(interface->spi_master, buf, len)) < 0) {
-        LOG_ERROR("spi_master_write");
-        return ret;
+      // previous write has completed after open
+      if (spi_master_write_stats(interface->spi_master, &len, &us) || !us) {
+        return;
       }
 
-      LOG_DEBUG("spi_master=%p write %p @ %u -> %d", interface->spi_master, buf, len, ret);
+      stats_gauge_sample(&stats->throughput, len * 8 * 1000 / us);
 
-      buf += ret;
-      len -= ret;
+      if (interface->spi_write_options.clock) {
+        stats_gauge_sample(&stats->clock, spi_clock_rate(interface->spi_write_options.clock) / 1000);
+      }
     }
 
-    return 0;
-  }
+    static int leds_interface_spi_master_start(struct leds_interface_spi *interface, size_t len)
+    {
+      return spi_master_write_buffer(interface->spi_master, interface->buf.p, len);
+    }
+
+    static int leds_interface_spi_master_write(struct leds_interface_spi *interface, size_t len)
+    {
+      int err;
+
+      if ((err = spi_master_write_buffer(interface->spi_master, interface->buf.p, len))) {
+        LOG_ERROR("spi_master_write_buffer");
+        return err;
+      }
+
+      // buf is re-used for the following data
+      return spi_master_flush(interface->spi_master);
+    }
+  #else
+    static int leds_interface_spi_master_write(struct leds_interface_spi *interface, size_t len)
+    {
+      uint8_t *buf = interface->buf.u8;
+      int ret;
+
+      while (len) {
+        if ((ret = spi_master_write(interface->spi_master, buf, len)) < 0) {
+          LOG_ERROR("spi_master_write");
+          return ret;
+        }
+
+        LOG_DEBUG("spi_master=%p write %p @ %u -> %d", interface->spi_master, buf, len, ret);
+
+        buf += ret;
+        len -= ret;
+      }
+
+      return 0;
+    }
+  #endif
 
   static int leds_interface_spi_master_flush(struct leds_interface_spi *interface)
   {
@@ -137,8 +175,8 @@
     }
 
     // use DMA-capable memory for the TX buffer
-    if (!(interface->buf.p = heap_caps_malloc(interface->buf_size, MALLOC_CAP_DMA))) {
-      LOG_ERROR("heap_caps_malloc(%u)", interface->buf_size);
+    if (!(interface->buf.p = system_heap_malloc(&leds_heap_usage, SYSTEM_HEAP_DMA, interface->buf_size))) {
+      LOG_ERROR("system_heap_malloc(%u)", interface->buf_size);
       return -1;
     }
 
@@ -174,17 +212,20 @@
 
 #endif
 
-int leds_interface_spi_init(struct leds_interface_spi *interface, const struct leds_interface_spi_options *options, enum leds_interface_spi_mode mode, union leds_interface_spi_func func)
+int leds_interface_spi_init(struct leds_interface_spi *interface, const struct leds_interface_spi_options *options, enum leds_interface_spi_mode mode, union leds_interface_spi_func func, unsigned count)
 {
   int err;
 
   interface->mode = mode;
   interface->func = func;
-  interface->buf_size = leds_interface_spi_buffer_size(mode, 0); // XXX: count is unknown?!
+  interface->buf_size = leds_interface_spi_buffer_size(mode, count);
+
+  // encode complete frame in place, and only re-encode changed pixels
+  interface->buf_frame = leds_interface_spi_buf_count(mode, count) * leds_interface_spi_buf_size(mode) <= interface->buf_size;
+  interface->buf_valid = false;
 
-  LOG_INFO("using buf_size=%u", interface->buf_size);
+  LOG_INFO("using buf_size=%u buf_frame=%d", interface->buf_size, interface->buf_frame);
 
-  // TODO: use larger buffer for more efficient transactions?
   if ((err = leds_interface_spi_master_init(interface, options))) {
     LOG_ERROR("leds_interface_spi_master_init");
     return err;
@@ -250,6 +291,81 @@ static int leds_interface_spi_flush_32bit(struct leds_interface_spi *interface,
   return 0;
 }
 
+#if CONFIG_LEDS_SPI_INTR_WRITE_ENABLED
+/* Return from tx without waiting for the frame to be written out */
+static bool leds_interface_spi_pipeline(struct leds_interface_spi *interface)
+{
+#if CONFIG_LEDS_GPIO_ENABLED
+  // active GPIO pins are cleared at the end of tx
+  if (interface->gpio.gpio_options && interface->gpio.mode == LEDS_GPIO_MODE_ACTIVE) {
+    return false;
+  }
+#endif
+
+  return true;
+}
+#endif
+
+static int leds_interface_spi_tx_32bit_frame(struct leds_interface_spi *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty)
+{
+  uint32_t *buf = interface->buf.spi_mode_32bit;
+  unsigned end_frames = leds_interface_spi_mode_32bit_end_frames(count);
+  size_t encode_size = 0;
+  int err;
+
+  if (!interface->buf_valid) {
+    // start frame
+    buf[0] = LEDS_INTERFACE_SPI_MODE_32BIT_START_FRAME;
+
+    // end frames
+    for (unsigned i = 0; i < end_frames; i++) {
+      buf[1 + count + i] = LEDS_INTERFACE_SPI_MODE_32BIT_END_FRAME;
+    }
+
+    // all pixel frames
+    dirty = NULL;
+  }
+
+  // changed pixel frames
+  for (unsigned i = 0; i < count; ) {
+    struct leds_dirty_range range = leds_dirty_next(dirty, i, count);
+
+    for (i = range.start; i < range.end; i++) {
+      interface->func.spi_mode_32bit(&buf[1 + i], pixels, i, limit);
+    }
+
+    encode_size += (range.end - range.start) * sizeof(*buf);
+  }
+
+  interface->buf_valid = true;
+
+  stats_gauge_sample(&leds_interface_stats.spi.encode, encode_size);
+
+#if CONFIG_LEDS_SPI_INTR_WRITE_ENABLED
+  if (leds_interface_spi_pipeline(interface)) {
+    // next open waits for the write to complete before re-encoding the buf
+    if ((err = leds_interface_spi_master_start(interface, (1 + count + end_frames) * sizeof(*buf)))) {
+      LOG_ERROR("leds_interface_spi_master_start");
+      return err;
+    }
+
+    return 0;
+  }
+#endif
+
+  if ((err = leds_interface_spi_master_write(interface, (1 + count + end_frames) * sizeof(*buf)))) {
+    LOG_ERROR("leds_interface_spi_master_write");
+    return err;
+  }
+
+  if ((err = leds_interface_spi_master_flush(interface))) {
+    LOG_ERROR("leds_interface_spi_master_flush");
+    return err;
+  }
+
+  return 0;
+}
+
 static int leds_interface_spi_tx_32bit(struct leds_interface_spi *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit)
 {
   unsigned off = 0;
@@ -286,10 +402,12 @@ static int leds_interface_spi_tx_32bit(struct leds_interface_spi *interface, con
     return err;
   }
 
+  stats_gauge_sample(&leds_interface_stats.spi.encode, count * sizeof(uint32_t));
+
   return 0;
 }
 
-int leds_interface_spi_tx(struct leds_interface_spi *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit)
+int leds_interface_spi_tx(struct leds_interface_spi *interface, const struct leds_color *pixels, unsigned count, const struct leds_limit *limit, const struct leds_dirty *dirty)
 {
   struct leds_interface_spi_stats *stats = &leds_interface_stats.spi;
   int err;
@@ -301,6 +419,10 @@ int leds_interface_spi_tx(struct leds_interface_spi *interface, const struct led
     }
   }
 
+#if CONFIG_LEDS_SPI_INTR_WRITE_ENABLED
+  leds_interface_spi_master_stats(interface);
+#endif
+
 #if CONFIG_LEDS_GPIO_ENABLED
   leds_gpio_setup(&interface->gpio);
 #endif
@@ -311,9 +433,16 @@ int leds_interface_spi_tx(struct leds_interface_spi *interface, const struct led
       case LEDS_INTERFACE_SPI_MODE1_32BIT:
       case LEDS_INTERFACE_SPI_MODE2_32BIT:
       case LEDS_INTERFACE_SPI_MODE3_32BIT:
-        if ((err = leds_interface_spi_tx_32bit(interface, pixels, count, limit))) {
-          LOG_ERROR("leds_interface_spi_tx_32bit");
-          goto error;
+        if (interface->buf_frame) {
+          if ((err = leds_interface_spi_tx_32bit_frame(interface, pixels, count, limit, dirty))) {
+            LOG_ERROR("leds_interface_spi_tx_32bit_frame");
+            goto error;
+          }
+        } else {
+          if ((err = leds_interface_spi_tx_32bit(interface, pixels, count, limit))) {
+            LOG_ERROR("leds_interface_spi_tx_32bit");
+            goto error;
+          }
         }
 
         break;
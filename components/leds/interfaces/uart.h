@@ -19,10 +19,13 @@
     void (*uart_mode_32B2I6)(uint16_t buf[8], const struct leds_color *pixels, unsigned index, const struct leds_limit *limit);
   };
 
+  // number of pixels to encode per uart_write(), 128..256 bytes to match the 128-byte UART TX FIFO
+  #define LEDS_INTERFACE_UART_BLOCK_PIXELS 16
+
   union leds_interface_uart_buf {
-    uint16_t uart_mode_24B3I7[4];
-    uint16_t uart_mode_24B2I8[6];
-    uint16_t uart_mode_32B2I6[8];
+    uint16_t uart_mode_24B3I7[LEDS_INTERFACE_UART_BLOCK_PIXELS][4];
+    uint16_t uart_mode_24B2I8[LEDS_INTERFACE_UART_BLOCK_PIXELS][6];
+    uint16_t uart_mode_32B2I6[LEDS_INTERFACE_UART_BLOCK_PIXELS][8];
   };
 
   #define LEDS_INTERFACE_UART_FUNC(type, func) ((union leds_interface_uart_func) { .type = func })
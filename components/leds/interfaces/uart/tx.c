@@ -5,6 +5,7 @@
 
 #include <logging.h>
 
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
@@ -79,23 +80,47 @@ static int leds_interface_uart_write(struct leds_interface_uart *interface, void
   return 0;
 }
 
-int leds_interface_uart_tx_pixel(struct leds_interface_uart *interface, const struct leds_color *pixels, unsigned index, const struct leds_limit *limit)
+/* Encode count <= LEDS_INTERFACE_UART_BLOCK_PIXELS pixels starting at index, and write as a single block */
+static int leds_interface_uart_tx_block(struct leds_interface_uart *interface, const struct leds_color *pixels, unsigned index, unsigned count, const struct leds_limit *limit)
 {
   switch (interface->mode) {
     case LEDS_INTERFACE_UART_MODE_24B3I7_0U4_80U:
-      interface->func.uart_mode_24B3I7(interface->buf.uart_mode_24B3I7, pixels, index, limit);
+      for (unsigned i = 0; i < count; i++) {
+        interface->func.uart_mode_24B3I7(interface->buf.uart_mode_24B3I7[i], pixels, index + i, limit);
+      }
 
-      return leds_interface_uart_write(interface, interface->buf.uart_mode_24B3I7, sizeof(interface->buf.uart_mode_24B3I7));
+      return leds_interface_uart_write(interface, interface->buf.uart_mode_24B3I7, count * sizeof(interface->buf.uart_mode_24B3I7[0]));
 
     case LEDS_INTERFACE_UART_MODE_24B2I8_0U25_50U:
-      interface->func.uart_mode_24B2I8(interface->buf.uart_mode_24B2I8, pixels, index, limit);
+      for (unsigned i = 0; i < count; i++) {
+        interface->func.uart_mode_24B2I8(interface->buf.uart_mode_24B2I8[i], pixels, index + i, limit);
+      }
 
-      return leds_interface_uart_write(interface, interface->buf.uart_mode_24B2I8, sizeof(interface->buf.uart_mode_24B2I8));
+      return leds_interface_uart_write(interface, interface->buf.uart_mode_24B2I8, count * sizeof(interface->buf.uart_mode_24B2I8[0]));
 
     case LEDS_INTERFACE_UART_MODE_32B2I6_0U3_80U:
-      interface->func.uart_mode_32B2I6(interface->buf.uart_mode_32B2I6, pixels, index, limit);
+      for (unsigned i = 0; i < count; i++) {
+        interface->func.uart_mode_32B2I6(interface->buf.uart_mode_32B2I6[i], pixels, index + i, limit);
+      }
+
+      return leds_interface_uart_write(interface, interface->buf.uart_mode_32B2I6, count * sizeof(interface->buf.uart_mode_32B2I6[0]));
+
+    default:
+      LOG_FATAL("invalid mode=%d", interface->mode);
+  }
+}
+
+static size_t leds_interface_uart_pixel_size(struct leds_interface_uart *interface)
+{
+  switch (interface->mode) {
+    case LEDS_INTERFACE_UART_MODE_24B3I7_0U4_80U:
+      return sizeof(interface->buf.uart_mode_24B3I7[0]);
+
+    case LEDS_INTERFACE_UART_MODE_24B2I8_0U25_50U:
+      return sizeof(interface->buf.uart_mode_24B2I8[0]);
 
-      return leds_interface_uart_write(interface, interface->buf.uart_mode_32B2I6, sizeof(interface->buf.uart_mode_32B2I6));
+    case LEDS_INTERFACE_UART_MODE_32B2I6_0U3_80U:
+      return sizeof(interface->buf.uart_mode_32B2I6[0]);
 
     default:
       LOG_FATAL("invalid mode=%d", interface->mode);
@@ -137,12 +162,16 @@ int leds_interface_uart_tx(struct leds_interface_uart *interface, const struct l
 #endif
 
   WITH_STATS_TIMER(&stats->tx) {
+    int64_t start = esp_timer_get_time();
+
     // temporarily raise task priority to ensure uart TX buffer does not starve
     vTaskPrioritySet(NULL, UART_TX_TASK_PRIORITY);
 
-    for (unsigned i = 0; i < count; i++) {
-      if ((err = leds_interface_uart_tx_pixel(interface, pixels, i, limit))) {
-        LOG_ERROR("leds_interface_uart_tx_pixel");
+    for (unsigned i = 0; i < count; i += LEDS_INTERFACE_UART_BLOCK_PIXELS) {
+      unsigned block = count - i < LEDS_INTERFACE_UART_BLOCK_PIXELS ? count - i : LEDS_INTERFACE_UART_BLOCK_PIXELS;
+
+      if ((err = leds_interface_uart_tx_block(interface, pixels, i, block, limit))) {
+        LOG_ERROR("leds_interface_uart_tx_block");
         goto error;
       }
     }
@@ -150,10 +179,18 @@ int leds_interface_uart_tx(struct leds_interface_uart *interface, const struct l
     // restore previous task priority
     vTaskPrioritySet(NULL, task_priority);
 
+    stats_gauge_sample(&stats->encode, count * leds_interface_uart_pixel_size(interface));
+
     if ((err = leds_interface_uart_tx_reset(interface))) {
       LOG_ERROR("leds_interface_uart_tx_reset");
       goto error;
     }
+
+    int64_t us = esp_timer_get_time() - start;
+
+    if (us > 0) {
+      stats_gauge_sample(&stats->pixel_rate, (uint64_t) count * 1000000 / us);
+    }
   }
 
 error:
@@ -8,6 +8,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+struct system_heap_usage leds_heap_usage = SYSTEM_HEAP_USAGE("leds");
+
 int leds_init(struct leds *leds, const struct leds_options *options)
 {
   int err;
@@ -21,12 +23,14 @@ int leds_init(struct leds *leds, const struct leds_options *options)
     return -1;
   }
 
-  if (!(leds->pixels = calloc(options->count, sizeof(*leds->pixels)))) {
-    LOG_ERROR("calloc");
+  // pixel state is only accessed from the leds task, and can be placed in external RAM
+  if (!(leds->pixels = system_heap_calloc(&leds_heap_usage, SYSTEM_HEAP_EXTERNAL, options->count, sizeof(*leds->pixels)))) {
+    LOG_ERROR("system_heap_calloc");
     return -1;
   }
 
   leds->pixels_limit_dirty = true;
+  leds_dirty_mark(&leds->pixels_dirty, 0, options->count);
 
   if ((err = leds_limit_init(&leds->limit, options->limit_groups, options->count))) {
     LOG_ERROR("leds_limit_init");
@@ -66,6 +70,7 @@ int leds_new(struct leds **ledsp, const struct leds_options *options)
   return 0;
 
 error:
+  system_heap_free(&leds_heap_usage, leds->pixels, options->count * sizeof(*leds->pixels));
   free(leds);
 
   return err;
@@ -106,10 +111,8 @@ void leds_clear_all(struct leds *leds)
   struct leds_color color = {}; // all off
 
   leds->pixels_limit_dirty = true;
-
-  for (unsigned i = 0; i < leds->options.count; i++) {
-    leds->pixels[i] = color;
-  }
+  leds_dirty_mark(&leds->pixels_dirty, 0, leds->options.count);
+  leds_colors_set(leds->pixels, leds->options.count, color);
 }
 
 int leds_set(struct leds *leds, unsigned index, struct leds_color color)
@@ -122,6 +125,7 @@ int leds_set(struct leds *leds, unsigned index, struct leds_color color)
   }
 
   leds->pixels_limit_dirty = true;
+  leds_dirty_mark(&leds->pixels_dirty, index, index + 1);
   leds->pixels[index] = color;
 
   return 0;
@@ -132,10 +136,8 @@ void leds_set_all(struct leds *leds, struct leds_color color)
   LOG_DEBUG("[%03d] %02x:%02x%02x%02x", leds->options.count, color.parameter, color.r, color.g, color.b);
 
   leds->pixels_limit_dirty = true;
-
-  for (unsigned i = 0; i < leds->options.count; i++) {
-    leds->pixels[i] = color;
-  }
+  leds_dirty_mark(&leds->pixels_dirty, 0, leds->options.count);
+  leds_colors_set(leds->pixels, leds->options.count, color);
 }
 
 unsigned leds_count_active(struct leds *leds)
@@ -157,7 +159,16 @@ bool leds_is_active(struct leds *leds)
 
 int leds_tx(struct leds *leds)
 {
+  int err;
+
   leds_limit_update(leds);
 
-  return leds_interface_tx(leds);
+  if ((err = leds_interface_tx(leds))) {
+    return err;
+  }
+
+  // interface is up to date
+  leds_dirty_clear(&leds->pixels_dirty);
+
+  return 0;
 }
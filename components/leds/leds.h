@@ -3,12 +3,18 @@
 #include <leds.h>
 #include <leds_status.h>
 
+#include "dirty.h"
 #include "interface.h"
 #include "protocol.h"
 
+#include <system_heap.h>
+
 #include <stdbool.h>
 #include <stddef.h>
 
+/* leds.c */
+extern struct system_heap_usage leds_heap_usage;
+
 struct leds {
   struct leds_options options;
 
@@ -21,6 +27,7 @@ struct leds {
   // pixel state
   struct leds_color *pixels;
   bool pixels_limit_dirty; // recalculate leds_limit_status
+  struct leds_dirty pixels_dirty; // changed pixels since last leds_tx()
 
   // limit used for leds_tx()
   struct leds_limit limit;
@@ -34,6 +41,22 @@ int leds_init(struct leds *leds, const struct leds_options *options);
 int leds_interface_init(union leds_interface_state *interface, const struct leds_protocol_type *protocol_type, const struct leds_options *options);
 
 /* color.c */
+union leds_color_word {
+  struct leds_color color;
+
+  // aligned with 0xPPBBGGRR on little-endian architectures
+  uint32_t word;
+};
+
+#define LEDS_COLOR_WORD_RGB       0x00ffffff
+#define LEDS_COLOR_WORD_PARAMETER 0xff000000
+
+static inline uint32_t leds_color_word(struct leds_color color)
+{
+  return (union leds_color_word) { .color = color }.word;
+}
+
+void leds_colors_set (struct leds_color *colors, unsigned count, struct leds_color color);
 unsigned leds_colors_active (const struct leds_color *colors, unsigned count, enum leds_parameter_type parameter_type);
 
 /* power.c */
@@ -69,8 +69,14 @@ void leds_limit_update(struct leds *leds)
       unsigned count = leds->limit.group_size;
       unsigned index = leds->limit.group_size * group;
       unsigned group_power = leds_power_total(leds->pixels, index, count, leds->protocol_type->power_mode);
+      uint16_t group_multiplier = leds->limit.group_multipliers[group];
       unsigned output_power = leds_limit_set_group(&leds->limit, group, leds->options.limit_group, group_power);
 
+      if (leds->limit.group_multipliers[group] != group_multiplier) {
+        // all group pixels need to be re-encoded
+        leds_dirty_mark(&leds->pixels_dirty, index, index + count);
+      }
+
       total_power += output_power;
 
       LOG_DEBUG("group[%u] limit=%u power=%u -> output power=%u", group,
@@ -91,8 +97,14 @@ void leds_limit_update(struct leds *leds)
   }
 
   // apply total limit
+  uint16_t total_multiplier = leds->limit.total_multipler;
   unsigned output_power = leds_limit_set_total(&leds->limit, leds->options.limit_total, total_power);
 
+  if (leds->limit.total_multipler != total_multiplier) {
+    // all pixels need to be re-encoded
+    leds_dirty_mark(&leds->pixels_dirty, 0, leds->options.count);
+  }
+
   LOG_DEBUG("total limit=%u power=%u -> output power=%u",
     leds->options.limit_total,
     total_power,
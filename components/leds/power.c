@@ -30,49 +30,71 @@ static inline unsigned leds_power_rgb2w(struct leds_color color)
   return color.r + color.g + color.b + (2 * color.white);
 }
 
-unsigned leds_power_total(const struct leds_color *pixels, unsigned index, unsigned count, enum leds_power_mode power_mode)
+/*
+ * Per-mode sums, to keep the power_mode switch out of the per-pixel loop.
+ */
+static unsigned leds_power_sum_rgb(const struct leds_color *pixels, unsigned count)
 {
   unsigned power = 0;
 
-  for (unsigned i = index; i < index + count; i++) {
-    switch (power_mode) {
-      case LEDS_POWER_NONE:
-        break;
+  for (unsigned i = 0; i < count; i++) {
+    power += leds_power_rgb(pixels[i]);
+  }
+
+  return power;
+}
+
+static unsigned leds_power_sum_rgba(const struct leds_color *pixels, unsigned count)
+{
+  unsigned power = 0;
+
+  for (unsigned i = 0; i < count; i++) {
+    power += leds_power_rgba(pixels[i]);
+  }
+
+  return power;
+}
+
+static unsigned leds_power_sum_rgbw(const struct leds_color *pixels, unsigned count)
+{
+  unsigned power = 0;
 
-      case LEDS_POWER_RGB:
-        power += leds_power_rgb(pixels[i]);
-        break;
+  for (unsigned i = 0; i < count; i++) {
+    power += leds_power_rgbw(pixels[i]);
+  }
 
-      case LEDS_POWER_RGBA:
-        power += leds_power_rgba(pixels[i]);
-        break;
+  return power;
+}
 
-      case LEDS_POWER_RGBW:
-        power += leds_power_rgbw(pixels[i]);
-        break;
+static unsigned leds_power_sum_rgb2w(const struct leds_color *pixels, unsigned count)
+{
+  unsigned power = 0;
 
-      case LEDS_POWER_RGB2W:
-        power += leds_power_rgb2w(pixels[i]);
-        break;
-    }
+  for (unsigned i = 0; i < count; i++) {
+    power += leds_power_rgb2w(pixels[i]);
   }
 
+  return power;
+}
+
+unsigned leds_power_total(const struct leds_color *pixels, unsigned index, unsigned count, enum leds_power_mode power_mode)
+{
   // use div_ceil() to ensure that we return >0 in case any led is set
   switch (power_mode) {
     case LEDS_POWER_NONE:
       return 0;
 
     case LEDS_POWER_RGB:
-      return div_ceil(power, (3 * 255));
+      return div_ceil(leds_power_sum_rgb(pixels + index, count), (3 * 255));
 
     case LEDS_POWER_RGBA:
-      return div_ceil(power, (3 * 255 * 31));
+      return div_ceil(leds_power_sum_rgba(pixels + index, count), (3 * 255 * 31));
 
     case LEDS_POWER_RGBW:
-      return div_ceil(power, (4 * 255));
+      return div_ceil(leds_power_sum_rgbw(pixels + index, count), (4 * 255));
 
     case LEDS_POWER_RGB2W:
-      return div_ceil(power, (5 * 255));
+      return div_ceil(leds_power_sum_rgb2w(pixels + index, count), (5 * 255));
 
     default:
       LOG_FATAL("invalid power_mode=%d", power_mode);
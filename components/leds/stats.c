@@ -11,22 +11,31 @@ void leds_reset_interface_stats()
 #if CONFIG_LEDS_SPI_ENABLED
   stats_timer_init(&leds_interface_stats.spi.open);
   stats_timer_init(&leds_interface_stats.spi.tx);
+  stats_gauge_init(&leds_interface_stats.spi.encode);
+#if CONFIG_LEDS_SPI_INTR_WRITE_ENABLED
+  stats_gauge_init(&leds_interface_stats.spi.throughput);
+  stats_gauge_init(&leds_interface_stats.spi.clock);
+#endif
 #endif
 #if CONFIG_LEDS_UART_ENABLED
   stats_timer_init(&leds_interface_stats.uart.open);
   stats_timer_init(&leds_interface_stats.uart.tx);
+  stats_gauge_init(&leds_interface_stats.uart.encode);
+  stats_gauge_init(&leds_interface_stats.uart.pixel_rate);
 #endif
 #if LEDS_I2S_INTERFACE_COUNT > 0
   stats_timer_init(&leds_interface_stats.i2s0.open);
   stats_timer_init(&leds_interface_stats.i2s0.write);
   stats_timer_init(&leds_interface_stats.i2s0.start);
   stats_timer_init(&leds_interface_stats.i2s0.flush);
+  stats_gauge_init(&leds_interface_stats.i2s0.encode);
 #endif
 #if LEDS_I2S_INTERFACE_COUNT > 1
   stats_timer_init(&leds_interface_stats.i2s1.open);
   stats_timer_init(&leds_interface_stats.i2s1.write);
   stats_timer_init(&leds_interface_stats.i2s1.start);
   stats_timer_init(&leds_interface_stats.i2s1.flush);
+  stats_gauge_init(&leds_interface_stats.i2s1.encode);
 #endif
 }
 
@@ -114,6 +114,33 @@ int spi_master_open(struct spi_master *spi_master, struct spi_write_options opti
  */
 int spi_master_write(struct spi_master *spi_master, void *data, size_t len);
 
+/*
+ * Send len bytes of data out via SPI MOSI, refilling the SPI FIFO from the SPI interrupt handler.
+ *
+ * Does not wait for transfer to complete when returning. When called, waits for any in-progress transfer to complete.
+ *
+ * The data MUST be uint32_t (4-byte) aligned, and MUST NOT be modified until spi_master_flush() or the next
+ * spi_master_open() returns. Any trailing len % 4 bytes are not sent.
+ *
+ * Returns <0 on error.
+ */
+int spi_master_write_buffer(struct spi_master *spi_master, const void *data, size_t len);
+
+/*
+ * Return size and duration of the most recently completed spi_master_write_buffer(), for throughput stats.
+ *
+ * Returns 0 and clears the stats, or >0 if no write has completed since the last call.
+ */
+int spi_master_write_stats(struct spi_master *spi_master, size_t *lenp, unsigned *usp);
+
+/*
+ * Return the configured SPI clock rate in Hz.
+ */
+static inline unsigned spi_clock_rate(enum spi_clock clock)
+{
+  return 80 * 1000 * 1000 / clock;
+}
+
 /*
  * wait write done
  */
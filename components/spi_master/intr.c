@@ -27,14 +27,16 @@ static inline void spi1_interrupt_clear()
 static IRAM_ATTR void spi1_interrupt(void *arg)
 {
   struct spi_master *spi_master = arg;
-  BaseType_t higher_task_woken;
+  BaseType_t higher_task_woken = pdFALSE;
+  bool trans_done = SPI1.slave.trans_done;
 
-  if (SPI1.slave.trans_done) {
+  // clear before starting the next transfer
+  spi1_interrupt_clear();
+
+  if (trans_done && !spi_master_write_next(spi_master)) {
     xSemaphoreGiveFromISR(spi_master->trans_done, &higher_task_woken);
   }
 
-  spi1_interrupt_clear();
-
   if (higher_task_woken) {
     portYIELD_FROM_ISR();
   }
@@ -50,9 +52,15 @@ int spi_master_intr_init(struct spi_master *spi_master)
   return 0;
 }
 
+void spi_master_intr_start(struct spi_master *spi_master)
+{
+  spi1_interrupt_clear();
+  spi1_intr_enable_trans();
+}
+
 int spi_master_intr_wait_trans_done(struct spi_master *spi_master, TickType_t block_time)
 {
-  spi1_intr_enable_trans(spi_master);
+  spi1_intr_enable_trans();
 
   if (!xSemaphoreTake(spi_master->trans_done, block_time)) {
     LOG_WARN("xSemaphoreTake");
@@ -11,6 +11,16 @@ struct spi_master {
 
   enum spi_mode mode;
   enum spi_clock clock;
+
+  /* spi_master_write_buffer() state, refilled from ISR */
+  const uint32_t *volatile write_ptr;
+  const uint32_t *write_end;
+  size_t write_len;
+  int64_t write_start;
+
+  /* last completed spi_master_write_buffer(), set from ISR */
+  volatile size_t write_done_len;
+  volatile unsigned write_done_us;
 };
 
 /* init.c */
@@ -22,7 +32,8 @@ int spi_master_pins(struct spi_master *spi_master, enum spi_pins pins);
 
 /* intr.c */
 int spi_master_intr_init(struct spi_master *spi_master);
+void spi_master_intr_start(struct spi_master *spi_master);
 int spi_master_intr_wait_trans_done(struct spi_master *spi_master, TickType_t block_time);
 
 /* write.c */
-void spi_master_trans_done_isr(struct spi_master *spi_master);
+bool spi_master_write_next(struct spi_master *spi_master);
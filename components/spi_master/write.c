@@ -3,13 +3,14 @@
 #include "spi_dev.h"
 #include <logging.h>
 
+#include <esp_attr.h>
+#include <esp_timer.h>
+
 // shrink size to aligment
 #define TRUNC(size, align) ((size) & ~((align) - 1))
 
-static inline void spi_master_mosi(struct spi_master *spi_master, uint32_t *data, unsigned count)
+static inline void spi_master_load(const uint32_t *data, unsigned count)
 {
-  LOG_DEBUG("spi_master=%p data=%p count=%u", spi_master, data, count);
-
   SPI_DEV.user1.usr_mosi_bitlen = count * 32 - 1;
 
   for (unsigned i = 0; i < count && i < 16; i++) {
@@ -17,6 +18,13 @@ static inline void spi_master_mosi(struct spi_master *spi_master, uint32_t *data
   }
 }
 
+static inline void spi_master_mosi(struct spi_master *spi_master, uint32_t *data, unsigned count)
+{
+  LOG_DEBUG("spi_master=%p data=%p count=%u", spi_master, data, count);
+
+  spi_master_load(data, count);
+}
+
 static inline void spi_master_start(struct spi_master *spi_master)
 {
   LOG_DEBUG("spi_master=%p", spi_master);
@@ -28,7 +36,7 @@ static int spi_master_wait_trans_done(struct spi_master *spi_master, TickType_t
 {
   int err;
 
-  while (SPI_DEV.cmd.usr) {
+  while (SPI_DEV.cmd.usr || spi_master->write_ptr < spi_master->write_end) {
     LOG_DEBUG("spi_master=%p: busy", spi_master);
 
     if ((err = spi_master_intr_wait_trans_done(spi_master, block_time))) {
@@ -120,6 +128,91 @@ int spi_master_write(struct spi_master *spi_master, void *data, size_t len)
   return len;
 }
 
+/* Called from ISR on trans done, returns true if the next transfer was started */
+IRAM_ATTR bool spi_master_write_next(struct spi_master *spi_master)
+{
+  const uint32_t *ptr = spi_master->write_ptr;
+  unsigned count = spi_master->write_end - ptr;
+
+  if (count) {
+    if (count > SPI_WRITE_MAX / sizeof(uint32_t)) {
+      count = SPI_WRITE_MAX / sizeof(uint32_t);
+    }
+
+    spi_master_load(ptr, count);
+
+    spi_master->write_ptr = ptr + count;
+
+    SPI_DEV.cmd.usr = 1;
+
+    return true;
+
+  } else if (spi_master->write_len) {
+    spi_master->write_done_len = spi_master->write_len;
+    spi_master->write_done_us = esp_timer_get_time() - spi_master->write_start;
+    spi_master->write_len = 0;
+  }
+
+  return false;
+}
+
+int spi_master_write_buffer(struct spi_master *spi_master, const void *data, size_t len)
+{
+  const uint32_t *ptr = data;
+  unsigned count = len / sizeof(uint32_t);
+  int err;
+
+  LOG_DEBUG("spi_master=%p data=%p len=%u", spi_master, data, len);
+
+  if (!count) {
+    return 0;
+  }
+
+  // wait
+  if ((err = spi_master_wait_trans_done(spi_master, portMAX_DELAY))) {
+    LOG_ERROR("spi_master_wait_trans_done");
+    return err;
+  }
+
+  // usr command structure: mosi only
+  SPI_DEV.user.usr_command = 0;
+  SPI_DEV.user.usr_addr = 0;
+  SPI_DEV.user.usr_dummy = 0;
+  SPI_DEV.user.usr_mosi = 1;
+  SPI_DEV.user.usr_miso = 0;
+
+  // first chunk, remaining chunks are loaded from the ISR
+  if (count > SPI_WRITE_MAX / sizeof(uint32_t)) {
+    count = SPI_WRITE_MAX / sizeof(uint32_t);
+  }
+
+  spi_master_load(ptr, count);
+
+  spi_master->write_ptr = ptr + count;
+  spi_master->write_end = ptr + len / sizeof(uint32_t);
+  spi_master->write_len = len / sizeof(uint32_t) * sizeof(uint32_t);
+  spi_master->write_start = esp_timer_get_time();
+
+  spi_master_intr_start(spi_master);
+  spi_master_start(spi_master);
+
+  return 0;
+}
+
+int spi_master_write_stats(struct spi_master *spi_master, size_t *lenp, unsigned *usp)
+{
+  if (!spi_master->write_done_len) {
+    return 1;
+  }
+
+  *lenp = spi_master->write_done_len;
+  *usp = spi_master->write_done_us;
+
+  spi_master->write_done_len = 0;
+
+  return 0;
+}
+
 int spi_master_flush(struct spi_master *spi_master)
 {
   return spi_master_wait_trans_done(spi_master, portMAX_DELAY);
@@ -0,0 +1,93 @@
+#include <stats_bench.h>
+#include <stats.h>
+
+#define STATS_BENCH_COUNTERS 4
+
+// file-scope, to keep updates in memory
+static struct stats_bench_timestamp_counter {
+  uint64_t update;
+  uint32_t count;
+} stats_bench_timestamp_counters[STATS_BENCH_COUNTERS];
+
+static struct stats_bench_timestamp_timer {
+  uint64_t update;
+  uint32_t count;
+  uint64_t total;
+} stats_bench_timestamp_timer;
+
+static struct stats_counter stats_bench_counters[STATS_BENCH_COUNTERS];
+static struct stats_timer stats_bench_timer;
+
+static volatile uint64_t stats_bench_clock;
+
+#define stats_bench_barrier() __asm__ __volatile__ ("" ::: "memory")
+
+static void stats_bench_clock_packets()
+{
+  for (unsigned i = 0; i < STATS_BENCH_PACKETS; i++) {
+    stats_bench_clock = esp_timer_get_time();
+  }
+}
+
+/* Equivalent of stats_counter/stats_timer with a timestamp per update */
+static void stats_bench_timestamp_packets()
+{
+  for (unsigned i = 0; i < STATS_BENCH_PACKETS; i++) {
+    uint64_t start = esp_timer_get_time();
+
+    for (unsigned j = 0; j < STATS_BENCH_COUNTERS; j++) {
+      stats_bench_timestamp_counters[j].update = esp_timer_get_time();
+      stats_bench_timestamp_counters[j].count++;
+    }
+
+    uint64_t stop = esp_timer_get_time();
+
+    stats_bench_timestamp_timer.update = esp_timer_get_time();
+    stats_bench_timestamp_timer.count++;
+    stats_bench_timestamp_timer.total += stop - start;
+
+    stats_bench_barrier();
+  }
+}
+
+static void stats_bench_counter_packets()
+{
+  for (unsigned i = 0; i < STATS_BENCH_PACKETS; i++) {
+    WITH_STATS_TIMER(&stats_bench_timer) {
+      for (unsigned j = 0; j < STATS_BENCH_COUNTERS; j++) {
+        stats_counter_increment(&stats_bench_counters[j]);
+      }
+    }
+
+    stats_bench_barrier();
+  }
+}
+
+int stats_bench(unsigned rounds, struct stats_bench_stats *stats)
+{
+  stats_timer_init(&stats->clock);
+  stats_timer_init(&stats->timestamp);
+  stats_timer_init(&stats->counter);
+
+  stats_timer_init(&stats_bench_timer);
+
+  for (unsigned j = 0; j < STATS_BENCH_COUNTERS; j++) {
+    stats_counter_init(&stats_bench_counters[j]);
+  }
+
+  for (unsigned round = 0; round < rounds; round++) {
+    WITH_STATS_TIMER(&stats->clock) {
+      stats_bench_clock_packets();
+    }
+
+    WITH_STATS_TIMER(&stats->timestamp) {
+      stats_bench_timestamp_packets();
+    }
+
+    WITH_STATS_TIMER(&stats->counter) {
+      stats_bench_counter_packets();
+    }
+  }
+
+  return 0;
+}
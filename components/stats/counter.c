@@ -1,5 +1,9 @@
 #include <stats_counter.h>
 
+#if CONFIG_IDF_TARGET_ESP32
+  portMUX_TYPE stats_counter_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
 struct stats_counter_metrics stats_counter_diff_metrics(const struct stats_counter *old, const struct stats_counter *new)
 {
   if ((!old->update || new->reset > old->reset) && !new->update) {
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stats_timer.h>
+
+// packets per measured round
+#define STATS_BENCH_PACKETS 100
+
+struct stats_bench_stats {
+  /* esp_timer_get_time() */
+  struct stats_timer clock;
+
+  /* Per-packet instrumentation with timestamped counter updates: 4x counter + timer */
+  struct stats_timer timestamp;
+
+  /* Per-packet instrumentation with stats_counter + stats_timer: 4x counter + timer */
+  struct stats_timer counter;
+};
+
+/*
+ * Measure per-packet cost of stats instrumentation, in rounds of STATS_BENCH_PACKETS.
+ */
+int stats_bench(unsigned rounds, struct stats_bench_stats *stats);
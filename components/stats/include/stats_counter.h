@@ -1,18 +1,47 @@
 #pragma once
 
 #include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <sdkconfig.h>
 
 #include <stdbool.h>
 
+#if CONFIG_STATS_LAZY_UPDATE
+  // plain increments, update timestamp sampled when read
+  #define STATS_LAZY_UPDATE 1
+#else
+  #define STATS_LAZY_UPDATE 0
+#endif
+
+#if CONFIG_IDF_TARGET_ESP8266
+  #define STATS_COUNTER_ENTER_CRITICAL() taskENTER_CRITICAL()
+  #define STATS_COUNTER_EXIT_CRITICAL() taskEXIT_CRITICAL()
+#elif CONFIG_IDF_TARGET_ESP32
+  // shared by stats_counter_copy() and stats_counter_increment_shared()
+  extern portMUX_TYPE stats_counter_mux;
+
+  #define STATS_COUNTER_ENTER_CRITICAL() taskENTER_CRITICAL(&stats_counter_mux)
+  #define STATS_COUNTER_EXIT_CRITICAL() taskEXIT_CRITICAL(&stats_counter_mux)
+#endif
+
 struct stats_counter {
   uint64_t reset, update;
   uint32_t count;
+
+#if STATS_LAZY_UPDATE
+  // count at last sampled update timestamp
+  uint32_t update_count;
+#endif
 };
 
 static inline void stats_counter_init(struct stats_counter *counter)
 {
   counter->reset = esp_timer_get_time();
   counter->count = 0;
+#if STATS_LAZY_UPDATE
+  counter->update_count = 0;
+#endif
 }
 
 static inline bool stats_counter_zero(const struct stats_counter *counter)
@@ -20,28 +49,78 @@ static inline bool stats_counter_zero(const struct stats_counter *counter)
   return counter->count == 0;
 }
 
+// IRAM-safe
 static inline void stats_counter_increment(struct stats_counter *counter)
 {
+#if !STATS_LAZY_UPDATE
   counter->update = esp_timer_get_time();
+#endif
   counter->count++;
 }
 
+// IRAM-safe
 static inline void stats_counter_add(struct stats_counter *counter, uint32_t value)
 {
+#if !STATS_LAZY_UPDATE
   counter->update = esp_timer_get_time();
+#endif
   counter->count += value;
 }
 
-static inline struct stats_counter stats_counter_copy(const struct stats_counter *counter)
+/* For counters incremented from more than one task, not ISR-safe */
+static inline void stats_counter_increment_shared(struct stats_counter *counter)
+{
+  STATS_COUNTER_ENTER_CRITICAL();
+  stats_counter_increment(counter);
+  STATS_COUNTER_EXIT_CRITICAL();
+}
+
+/* Return time of last update, or the current time if updated since last stats_counter_copy() */
+static inline uint64_t stats_counter_update_time(const struct stats_counter *counter)
 {
-  // TODO: locking for concurrent stats updates
-  return *counter;
+#if STATS_LAZY_UPDATE
+  if (counter->count != counter->update_count) {
+    return esp_timer_get_time();
+  }
+#endif
+  return counter->update;
+}
+
+/*
+ * Copy counter for reading, sampling the lazy update timestamp.
+ *
+ * Counters are read concurrently from HTTP, CLI and the system history task: the update timestamp write-back is done
+ * within a critical section, so that concurrent readers do not interleave their update/update_count writes. The owning
+ * task or ISR only writes the count.
+ */
+static inline struct stats_counter stats_counter_copy(struct stats_counter *counter)
+{
+  struct stats_counter copy;
+
+  STATS_COUNTER_ENTER_CRITICAL();
+
+#if STATS_LAZY_UPDATE
+  uint32_t count = counter->count;
+
+  if (count != counter->update_count) {
+    counter->update = esp_timer_get_time();
+    counter->update_count = count;
+  }
+#endif
+
+  copy = *counter;
+
+  STATS_COUNTER_EXIT_CRITICAL();
+
+  return copy;
 }
 
 static inline float stats_counter_seconds_passed(const struct stats_counter *counter)
 {
-  if (counter->update > counter->reset) {
-    return ((float)(counter->update - counter->reset)) / 1000000.0f;
+  uint64_t update = stats_counter_update_time(counter);
+
+  if (update > counter->reset) {
+    return ((float)(update - counter->reset)) / 1000000.0f;
   } else {
     return 0.0f;
   }
@@ -36,7 +36,7 @@ static inline void stats_timer_update(struct stats_timer *timer, stats_timer_sta
   
   uint64_t stop = esp_timer_get_time();
 
-  timer->update = esp_timer_get_time();
+  timer->update = stop;
   timer->count += 1;
   timer->total += stop - start;
 }
@@ -43,12 +43,21 @@ struct system_status {
   int cpu_frequency; // gz
 
   size_t total_heap_size, free_heap_size, minimum_free_heap_size, maximum_free_heap_size;
+
+  uint32_t boot_frame_us; // time from boot to first output frame, 0 if none yet
 };
 
 void system_image_info_get(struct system_image_info *info);
 void system_info_get(struct system_info *info);
 void system_status_get(struct system_status *status);
 
+/*
+ * Record the first output frame after boot, for system_status boot_frame_us.
+ *
+ * Cheap to call for every frame.
+ */
+void system_boot_frame();
+
 /* Memory */
 size_t system_get_total_heap_size();
 size_t system_get_free_heap_size();
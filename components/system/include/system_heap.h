@@ -0,0 +1,90 @@
+#pragma once
+
+#include <sdkconfig.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#if CONFIG_IDF_TARGET_ESP32 && CONFIG_ESP32_SPIRAM_SUPPORT
+# define SYSTEM_HEAP_SPIRAM_SUPPORTED 1
+#else
+# define SYSTEM_HEAP_SPIRAM_SUPPORTED 0
+#endif
+
+enum system_heap_placement {
+  /* Internal RAM, for buffers accessed by encode loops or ISRs */
+  SYSTEM_HEAP_INTERNAL,
+
+  /* DMA-capable internal RAM */
+  SYSTEM_HEAP_DMA,
+
+  /* External SPI RAM if present, falling back to internal RAM */
+  SYSTEM_HEAP_EXTERNAL,
+};
+
+enum system_heap_caps {
+  SYSTEM_HEAP_CAPS_INTERNAL,
+  SYSTEM_HEAP_CAPS_DMA,
+  SYSTEM_HEAP_CAPS_EXTERNAL,
+
+  SYSTEM_HEAP_CAPS_MAX
+};
+
+struct system_heap_caps_info {
+  size_t total_size, free_size;
+
+  // 0 if not supported
+  size_t minimum_free_size, largest_free_block, allocated_blocks;
+};
+
+const char *system_heap_caps_str(enum system_heap_caps caps);
+
+/*
+ * Get heap regions with the given capability.
+ *
+ * Returns 1 if not present.
+ */
+int system_heap_caps_info_get(enum system_heap_caps caps, struct system_heap_caps_info *info);
+
+/*
+ * Per-subsystem heap usage, registered on first allocation.
+ *
+ * Tracks the current size of buffers allocated via system_heap_malloc() and released via system_heap_free().
+ */
+struct system_heap_usage {
+  const char *name;
+
+  size_t internal_size, external_size;
+
+  struct system_heap_usage *next;
+  bool registered;
+};
+
+#define SYSTEM_HEAP_USAGE(_name) { .name = (_name) }
+
+/*
+ * Allocate memory using the given placement, accounted to the given usage.
+ *
+ * Use a NULL usage for temporary allocations that will be free()'d.
+ */
+void *system_heap_malloc(struct system_heap_usage *usage, enum system_heap_placement placement, size_t size);
+void *system_heap_calloc(struct system_heap_usage *usage, enum system_heap_placement placement, size_t count, size_t size);
+
+/*
+ * Free memory allocated using system_heap_malloc() or system_heap_calloc(), with the same usage and total size.
+ *
+ * No-op for a NULL ptr.
+ */
+void system_heap_free(struct system_heap_usage *usage, void *ptr, size_t size);
+
+/*
+ * External SPI RAM is present and available for SYSTEM_HEAP_EXTERNAL.
+ */
+bool system_heap_external();
+
+/*
+ * Call func for each registered subsystem, in order of registration.
+ *
+ * Stops and returns the first non-zero return value.
+ */
+int system_heap_usage_walk(int (*func)(const struct system_heap_usage *usage, void *ctx), void *ctx);
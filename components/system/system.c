@@ -21,6 +21,9 @@ size_t heap_caps_get_total_size(uint32_t caps);
 # include <esp32/clk.h>
 
 #endif
+/* Time of first output frame after boot */
+static int64_t boot_frame_time = 0;
+
 /* Crude tracking of heap size at boot */
 static size_t maximum_free_heap_size = 0;
 
@@ -36,7 +39,7 @@ size_t system_get_free_heap_size()
 
 size_t system_get_minimum_free_heap_size()
 {
-  return heap_caps_get_free_size( MALLOC_CAP_DEFAULT );
+  return esp_get_minimum_free_heap_size();
 }
 
 size_t system_get_maximum_free_heap_size()
@@ -75,6 +78,12 @@ void system_status_get(struct system_status *status)
   status->free_heap_size = system_get_free_heap_size();
   status->minimum_free_heap_size = system_get_minimum_free_heap_size();
   status->maximum_free_heap_size = system_get_maximum_free_heap_size();
+  status->boot_frame_us = boot_frame_time;
+}
 
-  // ESP32 TODO: heap_caps_get_info() for more detailed DRAM/IRAM numbers?
+void system_boot_frame()
+{
+  if (!boot_frame_time) {
+    boot_frame_time = esp_timer_get_time();
+  }
 }
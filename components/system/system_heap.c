@@ -0,0 +1,211 @@
+#include <system_heap.h>
+
+#include <esp_heap_caps.h>
+
+#if SYSTEM_HEAP_SPIRAM_SUPPORTED
+# include <soc/soc_memory_layout.h>
+#endif
+
+#if CONFIG_IDF_TARGET_ESP8266
+  // from system.c, using esp8266/heap_caps.c
+  size_t heap_caps_get_total_size(uint32_t caps);
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static struct system_heap_usage *system_heap_usage_head, **system_heap_usage_tail = &system_heap_usage_head;
+
+static void system_heap_usage_register(struct system_heap_usage *usage)
+{
+  if (usage->registered) {
+    return;
+  }
+
+  usage->registered = true;
+
+  *system_heap_usage_tail = usage;
+  system_heap_usage_tail = &usage->next;
+}
+
+static void *system_heap_alloc(enum system_heap_placement placement, size_t size, bool *externalp)
+{
+  void *ptr = NULL;
+
+  *externalp = false;
+
+  switch (placement) {
+    case SYSTEM_HEAP_EXTERNAL:
+    #if SYSTEM_HEAP_SPIRAM_SUPPORTED
+      if ((ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT))) {
+        *externalp = true;
+        return ptr;
+      }
+    #endif
+      // fallback
+      return system_heap_alloc(SYSTEM_HEAP_INTERNAL, size, externalp);
+
+    case SYSTEM_HEAP_INTERNAL:
+    #if SYSTEM_HEAP_SPIRAM_SUPPORTED
+      // malloc() may return external memory for large allocations
+      return heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    #else
+      return malloc(size);
+    #endif
+
+    case SYSTEM_HEAP_DMA:
+      return heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+
+    default:
+      return NULL;
+  }
+}
+
+void *system_heap_malloc(struct system_heap_usage *usage, enum system_heap_placement placement, size_t size)
+{
+  void *ptr;
+  bool external;
+
+  if (!(ptr = system_heap_alloc(placement, size, &external))) {
+    return NULL;
+  }
+
+  if (!usage) {
+    // not accounted
+  } else if (external) {
+    usage->external_size += size;
+  } else {
+    usage->internal_size += size;
+  }
+
+  if (usage) {
+    system_heap_usage_register(usage);
+  }
+
+  return ptr;
+}
+
+void *system_heap_calloc(struct system_heap_usage *usage, enum system_heap_placement placement, size_t count, size_t size)
+{
+  void *ptr;
+
+  if (size && count > SIZE_MAX / size) {
+    return NULL;
+  }
+
+  if ((ptr = system_heap_malloc(usage, placement, count * size))) {
+    memset(ptr, 0, count * size);
+  }
+
+  return ptr;
+}
+
+static void system_heap_usage_sub(size_t *sizep, size_t size)
+{
+  if (*sizep >= size) {
+    *sizep -= size;
+  } else {
+    *sizep = 0;
+  }
+}
+
+void system_heap_free(struct system_heap_usage *usage, void *ptr, size_t size)
+{
+  if (!ptr) {
+    return;
+  }
+
+  if (!usage) {
+    // not accounted
+  }
+#if SYSTEM_HEAP_SPIRAM_SUPPORTED
+  else if (esp_ptr_external_ram(ptr)) {
+    system_heap_usage_sub(&usage->external_size, size);
+  }
+#endif
+  else {
+    system_heap_usage_sub(&usage->internal_size, size);
+  }
+
+  free(ptr);
+}
+
+bool system_heap_external()
+{
+#if SYSTEM_HEAP_SPIRAM_SUPPORTED
+  return heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0;
+#else
+  return false;
+#endif
+}
+
+const char *system_heap_caps_str(enum system_heap_caps caps)
+{
+  switch (caps) {
+    case SYSTEM_HEAP_CAPS_INTERNAL:   return "internal";
+    case SYSTEM_HEAP_CAPS_DMA:        return "dma";
+    case SYSTEM_HEAP_CAPS_EXTERNAL:   return "external";
+    default:                          return NULL;
+  }
+}
+
+static uint32_t system_heap_caps_flags(enum system_heap_caps caps)
+{
+  switch (caps) {
+  #if CONFIG_IDF_TARGET_ESP8266
+    case SYSTEM_HEAP_CAPS_INTERNAL:   return MALLOC_CAP_32BIT;
+  #else
+    case SYSTEM_HEAP_CAPS_INTERNAL:   return MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+  #endif
+    case SYSTEM_HEAP_CAPS_DMA:        return MALLOC_CAP_DMA | MALLOC_CAP_8BIT;
+  #if SYSTEM_HEAP_SPIRAM_SUPPORTED
+    case SYSTEM_HEAP_CAPS_EXTERNAL:   return MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+  #endif
+    default:                          return 0;
+  }
+}
+
+int system_heap_caps_info_get(enum system_heap_caps caps, struct system_heap_caps_info *info)
+{
+  uint32_t flags = system_heap_caps_flags(caps);
+
+  if (!flags) {
+    return 1;
+  }
+
+  if (!(info->total_size = heap_caps_get_total_size(flags))) {
+    return 1;
+  }
+
+#if CONFIG_IDF_TARGET_ESP8266
+  info->free_size = heap_caps_get_free_size(flags);
+  info->minimum_free_size = 0;
+  info->largest_free_block = 0;
+  info->allocated_blocks = 0;
+#else
+  multi_heap_info_t heap_info;
+
+  heap_caps_get_info(&heap_info, flags);
+
+  info->free_size = heap_info.total_free_bytes;
+  info->minimum_free_size = heap_info.minimum_free_bytes;
+  info->largest_free_block = heap_info.largest_free_block;
+  info->allocated_blocks = heap_info.allocated_blocks;
+#endif
+
+  return 0;
+}
+
+int system_heap_usage_walk(int (*func)(const struct system_heap_usage *usage, void *ctx), void *ctx)
+{
+  int err;
+
+  for (const struct system_heap_usage *usage = system_heap_usage_head; usage; usage = usage->next) {
+    if ((err = func(usage, ctx))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,138 @@
+#include <uart.h>
+#include "uart.h"
+
+#include <logging.h>
+
+#if UART_TX_ISR_SUPPORTED
+  #include <esp_attr.h>
+  #include <esp_timer.h>
+  #include <hal/cpu_ll.h>
+
+  static enum uart_tx_isr_event IRAM_ATTR uart_tx_bulk_isr(struct uart *uart, enum uart_tx_isr_event event, void *arg)
+  {
+    struct uart_tx_bulk *bulk = &uart->tx_bulk;
+    uint32_t cycles = cpu_ll_get_cycle_count();
+    enum uart_tx_isr_event ret = UART_TX_ISR_STOP;
+
+    while (bulk->seg < bulk->end) {
+      const struct uart_tx_seg *seg = bulk->seg;
+
+      if (seg->break_bits && !bulk->seg_break) {
+        // sent by HW once the TX FIFO is empty
+        uart_isr_tx_break(uart, seg->break_bits, seg->mark_bits);
+
+        bulk->seg_break = true;
+
+        ret = UART_TX_ISR_BREAK;
+        goto out;
+
+      } else if (seg->break_bits && bulk->offset == 0 && event != UART_TX_ISR_BREAK) {
+        // triggered while still waiting for break
+        ret = UART_TX_ISR_BREAK;
+        goto out;
+      }
+
+      if (bulk->offset < seg->len) {
+        size_t write = uart_isr_tx_write(uart, (const uint8_t *) seg->buf + bulk->offset, seg->len - bulk->offset);
+
+        bulk->offset += write;
+        bulk->bytes += write;
+      }
+
+      if (bulk->offset < seg->len) {
+        // TX FIFO full
+        ret = UART_TX_ISR_EMPTY;
+        goto out;
+      }
+
+      bulk->seg++;
+      bulk->offset = 0;
+      bulk->seg_break = false;
+
+      // the next segment break is only sent once the TX FIFO is empty
+      event = UART_TX_ISR_EMPTY;
+    }
+
+    if (bulk->notify_task) {
+      BaseType_t task_woken = pdFALSE;
+
+      vTaskNotifyGiveFromISR(bulk->notify_task, &task_woken);
+
+      bulk->notify_task = NULL;
+
+      if (task_woken) {
+        portYIELD_FROM_ISR();
+      }
+    }
+
+  out:
+    bulk->isr_cycles += cpu_ll_get_cycle_count() - cycles;
+
+    return ret;
+  }
+
+  int uart_start_bulk(struct uart *uart, const struct uart_tx_seg *segs, unsigned count)
+  {
+    struct uart_tx_bulk *bulk = &uart->tx_bulk;
+    int err;
+
+    LOG_DEBUG("segs=%p count=%u", segs, count);
+
+    // not yet running, uart_start_tx_isr() will flush any previous TX before the first ISR call
+    *bulk = (struct uart_tx_bulk) {
+      .seg          = segs,
+      .end          = segs + count,
+      .notify_task  = xTaskGetCurrentTaskHandle(),
+      .start        = esp_timer_get_time(),
+    };
+
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    if ((err = uart_start_tx_isr(uart, uart_tx_bulk_isr, NULL))) {
+      LOG_ERROR("uart_start_tx_isr");
+      return err;
+    }
+
+    return 0;
+  }
+
+  int uart_wait_bulk(struct uart *uart, TickType_t timeout, struct uart_tx_bulk_stats *stats)
+  {
+    struct uart_tx_bulk *bulk = &uart->tx_bulk;
+    int err = 0;
+
+    if (!ulTaskNotifyTake(pdTRUE, timeout)) {
+      LOG_WARN("timeout");
+      err = -1;
+    }
+
+    // waits for TX FIFO to empty
+    if (uart_stop_tx_isr(uart, timeout)) {
+      LOG_ERROR("uart_stop_tx_isr");
+      err = -1;
+    }
+
+    bulk->notify_task = NULL;
+
+    if (stats) {
+      *stats = (struct uart_tx_bulk_stats) {
+        .bytes      = bulk->bytes,
+        .us         = esp_timer_get_time() - bulk->start,
+        .isr_cycles = bulk->isr_cycles,
+      };
+    }
+
+    return err;
+  }
+
+  int uart_write_bulk(struct uart *uart, const struct uart_tx_seg *segs, unsigned count, TickType_t timeout, struct uart_tx_bulk_stats *stats)
+  {
+    int err;
+
+    if ((err = uart_start_bulk(uart, segs, count))) {
+      return err;
+    }
+
+    return uart_wait_bulk(uart, timeout, stats);
+  }
+#endif
@@ -156,6 +156,27 @@ static void IRAM_ATTR uart_intr_rx_handler(struct uart *uart, BaseType_t *task_w
   uart_ll_clr_intsts_mask(uart->dev, UART_RX_READ_INTR_MASK);
 }
 
+static void IRAM_ATTR uart_intr_rx_isr_handler(struct uart *uart, uint32_t int_st, BaseType_t *task_woken)
+{
+  if (int_st & UART_INTR_RXFIFO_OVF) {
+    uart_ll_rxfifo_rst(uart->dev);
+
+    uart->rx_isr_func(uart, UART_RX_ISR_OVERFLOW, uart->rx_isr_arg, task_woken);
+
+  } else if (int_st & UART_INTR_BRK_DET) {
+    // the 0x00 break byte will also have a framing error
+    uart->rx_isr_func(uart, UART_RX_ISR_BREAK, uart->rx_isr_arg, task_woken);
+
+  } else if (int_st & UART_RX_ERROR_INTR_MASK) {
+    uart->rx_isr_func(uart, UART_RX_ISR_ERROR, uart->rx_isr_arg, task_woken);
+
+  } else {
+    uart->rx_isr_func(uart, UART_RX_ISR_DATA, uart->rx_isr_arg, task_woken);
+  }
+
+  uart_ll_clr_intsts_mask(uart->dev, int_st & UART_RX_INTR_MASK);
+}
+
 void IRAM_ATTR uart_intr_tx_done_handler(struct uart *uart, BaseType_t *task_woken)
 {
   if (uart->tx_done_notify_task) {
@@ -173,12 +194,55 @@ void IRAM_ATTR uart_intr_tx_done_handler(struct uart *uart, BaseType_t *task_wok
   uart_ll_clr_intsts_mask(uart->dev, UART_INTR_TX_DONE);
 }
 
+static void IRAM_ATTR uart_intr_tx_isr(struct uart *uart, enum uart_tx_isr_event event)
+{
+  switch (uart->tx_isr_func(uart, event, uart->tx_isr_arg)) {
+    case UART_TX_ISR_EMPTY:
+      uart_ll_disable_intr_mask(uart->dev, UART_INTR_TX_BRK_IDLE);
+      uart_ll_ena_intr_mask(uart->dev, UART_TX_WRITE_INTR_MASK);
+      break;
+
+    case UART_TX_ISR_BREAK:
+      uart_ll_disable_intr_mask(uart->dev, UART_TX_WRITE_INTR_MASK);
+      uart_ll_ena_intr_mask(uart->dev, UART_INTR_TX_BRK_IDLE);
+      break;
+
+    case UART_TX_ISR_STOP:
+      LOG_ISR_DEBUG("tx isr idle");
+
+      uart_ll_disable_intr_mask(uart->dev, UART_TX_ISR_INTR_MASK);
+      break;
+  }
+}
+
+void IRAM_ATTR uart_intr_tx_break_handler(struct uart *uart, BaseType_t *task_woken)
+{
+  // stop sending further breaks
+  uart_ll_tx_break(uart->dev, 0);
+
+  if (uart->tx_isr_func) {
+    uart_intr_tx_isr(uart, UART_TX_ISR_BREAK);
+  } else {
+    uart_ll_disable_intr_mask(uart->dev, UART_INTR_TX_BRK_IDLE);
+  }
+
+  uart_ll_clr_intsts_mask(uart->dev, UART_INTR_TX_BRK_IDLE);
+}
+
 void IRAM_ATTR uart_intr_tx_handler(struct uart *uart, BaseType_t *task_woken)
 {
   uint8_t buf[UART_TX_BUF_SIZE];
   size_t size = uart_ll_get_txfifo_len(uart->dev);
   size_t len;
 
+  if (uart->tx_isr_func) {
+    // bypass TX buffer
+    uart_intr_tx_isr(uart, UART_TX_ISR_EMPTY);
+    uart_ll_clr_intsts_mask(uart->dev, UART_TX_WRITE_INTR_MASK);
+
+    return;
+  }
+
   if (size > sizeof(buf)) {
     // partially fill TX queue
     size = sizeof(buf);
@@ -226,22 +290,31 @@ void IRAM_ATTR uart_intr_handler(void *ctx)
 
   taskENTER_CRITICAL_ISR(&uart->mux);
 
-  if (int_st & UART_INTR_RXFIFO_OVF) {
-    uart_intr_rx_overflow_handler(uart, &task_woken);
-  }
-  if (int_st & UART_RX_ERROR_INTR_MASK) {
-    uart_intr_rx_error_handler(uart, &task_woken);
-  }
-  if (int_st & UART_INTR_BRK_DET) {
-    uart_intr_rx_break_handler(uart, &task_woken);
-  }
-  if (int_st & UART_RX_READ_INTR_MASK) {
-    uart_intr_rx_handler(uart, &task_woken);
+  if (uart->rx_isr_func) {
+    if (int_st & UART_RX_INTR_MASK) {
+      uart_intr_rx_isr_handler(uart, int_st, &task_woken);
+    }
+  } else {
+    if (int_st & UART_INTR_RXFIFO_OVF) {
+      uart_intr_rx_overflow_handler(uart, &task_woken);
+    }
+    if (int_st & UART_RX_ERROR_INTR_MASK) {
+      uart_intr_rx_error_handler(uart, &task_woken);
+    }
+    if (int_st & UART_INTR_BRK_DET) {
+      uart_intr_rx_break_handler(uart, &task_woken);
+    }
+    if (int_st & UART_RX_READ_INTR_MASK) {
+      uart_intr_rx_handler(uart, &task_woken);
+    }
   }
 
   if (int_st & UART_TX_WRITE_INTR_MASK) {
     uart_intr_tx_handler(uart, &task_woken);
   }
+  if (int_st & UART_INTR_TX_BRK_IDLE) {
+    uart_intr_tx_break_handler(uart, &task_woken);
+  }
   if (int_st & UART_INTR_TX_DONE) {
     uart_intr_tx_done_handler(uart, &task_woken);
   }
@@ -200,3 +200,56 @@ void uart_rx_abort(struct uart *uart)
 
   taskEXIT_CRITICAL(&uart->mux);
 }
+
+void uart_rx_isr_setup(struct uart *uart, uart_rx_isr_func_t func, void *arg)
+{
+  taskENTER_CRITICAL(&uart->mux);
+
+  uart_ll_rxfifo_rst(uart->dev);
+
+  uart->rx_isr_func = func;
+  uart->rx_isr_arg = arg;
+
+  uart_ll_clr_intsts_mask(uart->dev, UART_RX_INTR_MASK);
+  uart_ll_ena_intr_mask(uart->dev, UART_RX_INTR_MASK);
+
+  taskEXIT_CRITICAL(&uart->mux);
+}
+
+void uart_rx_isr_teardown(struct uart *uart)
+{
+  taskENTER_CRITICAL(&uart->mux);
+
+  uart->rx_isr_func = NULL;
+  uart->rx_isr_arg = NULL;
+
+  uart_ll_rxfifo_rst(uart->dev);
+  uart_ll_clr_intsts_mask(uart->dev, UART_RX_INTR_MASK);
+
+  if (uart->rx_buffer) {
+    uart_ll_ena_intr_mask(uart->dev, UART_RX_INTR_MASK);
+  } else {
+    uart_ll_disable_intr_mask(uart->dev, UART_RX_INTR_MASK);
+  }
+
+  taskEXIT_CRITICAL(&uart->mux);
+}
+
+size_t IRAM_ATTR uart_isr_rx_len(struct uart *uart)
+{
+  return uart_ll_get_rxfifo_len(uart->dev);
+}
+
+void IRAM_ATTR uart_isr_rx_read(struct uart *uart, uint8_t *buf, size_t len)
+{
+  for (uint8_t *ptr = buf; ptr < buf + len; ptr++) {
+    *ptr = uart_rx_read_rxfifo_byte(uart);
+  }
+}
+
+void IRAM_ATTR uart_isr_rx_skip(struct uart *uart, size_t len)
+{
+  while (len--) {
+    uart_rx_read_rxfifo_byte(uart);
+  }
+}
@@ -246,3 +246,66 @@ int uart_tx_mark(struct uart *uart, unsigned bits)
 
   return 0;
 }
+
+void uart_tx_isr_setup(struct uart *uart, uart_tx_isr_func_t func, void *arg)
+{
+  taskENTER_CRITICAL(&uart->mux);
+
+  uart->tx_isr_func = func;
+  uart->tx_isr_arg = arg;
+
+  // start with an EMPTY event
+  uart_ll_set_txfifo_empty_thr(uart->dev, UART_TX_EMPTY_THRD_DEFAULT);
+  uart_ll_clr_intsts_mask(uart->dev, UART_TX_ISR_INTR_MASK);
+  uart_ll_ena_intr_mask(uart->dev, UART_TX_WRITE_INTR_MASK);
+
+  taskEXIT_CRITICAL(&uart->mux);
+}
+
+void uart_tx_isr_trigger(struct uart *uart)
+{
+  taskENTER_CRITICAL(&uart->mux);
+
+  if (uart->tx_isr_func) {
+    uart_ll_ena_intr_mask(uart->dev, UART_TX_WRITE_INTR_MASK);
+  }
+
+  taskEXIT_CRITICAL(&uart->mux);
+}
+
+void uart_tx_isr_teardown(struct uart *uart)
+{
+  taskENTER_CRITICAL(&uart->mux);
+
+  uart->tx_isr_func = NULL;
+  uart->tx_isr_arg = NULL;
+
+  uart_ll_disable_intr_mask(uart->dev, UART_TX_ISR_INTR_MASK);
+  uart_ll_clr_intsts_mask(uart->dev, UART_TX_ISR_INTR_MASK);
+
+  // cancel any pending break
+  uart_ll_tx_break(uart->dev, 0);
+  uart_ll_set_tx_idle_num(uart->dev, 0);
+
+  taskEXIT_CRITICAL(&uart->mux);
+}
+
+size_t IRAM_ATTR uart_isr_tx_write(struct uart *uart, const uint8_t *buf, size_t len)
+{
+  size_t write = uart_ll_get_txfifo_len(uart->dev);
+
+  if (write > len) {
+    write = len;
+  }
+
+  uart_ll_write_txfifo(uart->dev, buf, write);
+
+  return write;
+}
+
+void IRAM_ATTR uart_isr_tx_break(struct uart *uart, unsigned break_bits, unsigned mark_bits)
+{
+  // the HW sends the break once the TX FIFO is empty, followed by tx_idle_num idle bits, and then triggers TX_BRK_IDLE
+  uart_ll_set_tx_idle_num(uart->dev, mark_bits);
+  uart_ll_tx_break(uart->dev, break_bits);
+}
@@ -20,3 +20,6 @@ static inline void uart_tx_inv(struct uart *uart, bool inv)
 {
   uart->dev->conf0.txd_inv = inv;
 }
+
+// interrupts used by uart_start_tx_isr()
+#define UART_TX_ISR_INTR_MASK (UART_INTR_TXFIFO_EMPTY | UART_INTR_TX_BRK_IDLE)
@@ -5,6 +5,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <sys/types.h>
 
 #if CONFIG_IDF_TARGET_ESP8266
@@ -19,6 +20,8 @@
   #define UART_PORT_MASK  0x0ff
 
   #define UART_IO_PINS_SUPPORTED 0
+  #define UART_TX_ISR_SUPPORTED 0
+  #define UART_RX_ISR_SUPPORTED 0
 
   // flag bits
   #define UART_SWAP_BIT   0x100   // swap RTS/CST AND RX/TX pins
@@ -64,6 +67,8 @@
   #define UART_PORT_MASK  0x0ff
 
   #define UART_IO_PINS_SUPPORTED 1
+  #define UART_TX_ISR_SUPPORTED 1
+  #define UART_RX_ISR_SUPPORTED 1
 
 #else
   #error Unsupported target
@@ -161,6 +166,56 @@ int uart_read(struct uart *uart, void *buf, size_t size, TickType_t timeout);
  */
 int uart_abort_read(struct uart *uart);
 
+#if UART_RX_ISR_SUPPORTED
+  enum uart_rx_isr_event {
+    // RX FIFO has data
+    UART_RX_ISR_DATA,
+
+    // RX break detected, the RX FIFO contains any data preceding the break, followed by the 0x00 break byte
+    UART_RX_ISR_BREAK,
+
+    // RX framing/parity error, the last byte in the RX FIFO is invalid
+    UART_RX_ISR_ERROR,
+
+    // RX FIFO overflowed, and was reset
+    UART_RX_ISR_OVERFLOW,
+  };
+
+  /**
+   * Called from the UART ISR for the given event. Must consume the RX FIFO using `uart_isr_rx_read()` or
+   * `uart_isr_rx_skip()`.
+   *
+   * The callback must be in IRAM, and only use ISR-safe functions.
+   */
+  typedef void (*uart_rx_isr_func_t)(struct uart *uart, enum uart_rx_isr_event event, void *arg, BaseType_t *task_woken);
+
+  /**
+   * Reset the RX FIFO, and read RX directly from the UART ISR using the given callback, bypassing the RX buffer.
+   * The RX must be open, and `uart_read()` must not be used until `uart_stop_rx_isr()`.
+   */
+  int uart_start_rx_isr(struct uart *uart, uart_rx_isr_func_t func, void *arg);
+
+  /**
+   * Stop calling the callback, and resume using the RX buffer, if any.
+   */
+  int uart_stop_rx_isr(struct uart *uart);
+
+  /**
+   * ISR-safe: number of bytes in the RX FIFO.
+   */
+  size_t uart_isr_rx_len(struct uart *uart);
+
+  /**
+   * ISR-safe: read len bytes from the RX FIFO into buf. Must not exceed `uart_isr_rx_len()`.
+   */
+  void uart_isr_rx_read(struct uart *uart, uint8_t *buf, size_t len);
+
+  /**
+   * ISR-safe: discard len bytes from the RX FIFO. Must not exceed `uart_isr_rx_len()`.
+   */
+  void uart_isr_rx_skip(struct uart *uart, size_t len);
+#endif
+
 /**
  * Releaes RX mutex for calling task.
  */
@@ -213,6 +268,101 @@ int uart_break(struct uart *uart, unsigned break_bits, unsigned mark_bits, TickT
  */
 int uart_mark(struct uart *uart, unsigned mark_bits, TickType_t timeout);
 
+#if UART_TX_ISR_SUPPORTED
+  enum uart_tx_isr_event {
+    UART_TX_ISR_STOP = 0,
+
+    // TX FIFO below empty threshold, use uart_isr_tx_write()
+    UART_TX_ISR_EMPTY,
+
+    // TX break and following mark complete, after uart_isr_tx_break()
+    UART_TX_ISR_BREAK,
+  };
+
+  /**
+   * Called from the UART ISR for the given event. Returns the next event to wait for, or UART_TX_ISR_STOP to go idle
+   * until `uart_trigger_tx_isr()`.
+   *
+   * The callback must be in IRAM, and only use the ISR-safe `uart_isr_tx_*()` functions.
+   */
+  typedef enum uart_tx_isr_event (*uart_tx_isr_func_t)(struct uart *uart, enum uart_tx_isr_event event, void *arg);
+
+  /**
+   * Flush TX, and write TX directly from the UART ISR using the given callback, bypassing the TX buffer.
+   * The TX must be open, and must not be written to until `uart_stop_tx_isr()`.
+   *
+   * The callback is called with UART_TX_ISR_EMPTY once started.
+   */
+  int uart_start_tx_isr(struct uart *uart, uart_tx_isr_func_t func, void *arg);
+
+  /**
+   * Call the callback with UART_TX_ISR_EMPTY, from ISR context. Safe to call while the callback is busy.
+   */
+  void uart_trigger_tx_isr(struct uart *uart);
+
+  /**
+   * Stop calling the callback, and wait for TX to complete.
+   */
+  int uart_stop_tx_isr(struct uart *uart, TickType_t timeout);
+
+  /**
+   * ISR-safe: write up to len bytes into the TX FIFO, without blocking.
+   *
+   * Returns number of bytes written.
+   */
+  size_t uart_isr_tx_write(struct uart *uart, const uint8_t *buf, size_t len);
+
+  /**
+   * ISR-safe: once the TX FIFO is empty, hold the line low for `break_bits` bauds, followed by `mark_bits` idle.
+   *
+   * The callback should return UART_TX_ISR_BREAK to wait for completion.
+   */
+  void uart_isr_tx_break(struct uart *uart, unsigned break_bits, unsigned mark_bits);
+
+  /**
+   * One segment of a bulk TX frame.
+   */
+  struct uart_tx_seg {
+    // if set, hold the line low for >= `break_bits` bauds, followed by >= `mark_bits` idle, before the data
+    unsigned break_bits, mark_bits;
+
+    const void *buf;
+    size_t len;
+  };
+
+  struct uart_tx_bulk_stats {
+    // data bytes written
+    size_t bytes;
+
+    // from uart_start_bulk() until TX complete
+    uint32_t us;
+
+    // CPU cycles spent writing the TX FIFO from the UART ISR
+    uint32_t isr_cycles;
+  };
+
+  /**
+   * Flush TX, and write the given segments directly from the UART ISR into the TX FIFO, without copying into the TX buffer.
+   * The TX must be open, and must not be written to until `uart_wait_bulk()`.
+   *
+   * The segments and buffers must remain valid until `uart_wait_bulk()` returns.
+   */
+  int uart_start_bulk(struct uart *uart, const struct uart_tx_seg *segs, unsigned count);
+
+  /**
+   * Wait for the ISR to complete writing the segments given to `uart_start_bulk()`, and for TX to complete.
+   *
+   * @param stats optional, returns stats for the completed bulk write
+   * @return <0 on error or timeout
+   */
+  int uart_wait_bulk(struct uart *uart, TickType_t timeout, struct uart_tx_bulk_stats *stats);
+
+  /**
+   * Write a complete frame of segments, using `uart_start_bulk()` and `uart_wait_bulk()`.
+   */
+  int uart_write_bulk(struct uart *uart, const struct uart_tx_seg *segs, unsigned count, TickType_t timeout, struct uart_tx_bulk_stats *stats);
+#endif
+
 /**
  * Flush TX and release TX mutex acquire dusing `uart_open_tx()`.
  */
@@ -298,6 +298,42 @@ int uart_abort_read(struct uart *uart)
   return 0;
 }
 
+#if UART_RX_ISR_SUPPORTED
+int uart_start_rx_isr(struct uart *uart, uart_rx_isr_func_t func, void *arg)
+{
+  int err;
+
+  if ((err = uart_acquire_rx(uart))) {
+    return err;
+  }
+
+  LOG_DEBUG("func=%p arg=%p", func, arg);
+
+  uart_rx_isr_setup(uart, func, arg);
+
+  uart_release_rx(uart);
+
+  return 0;
+}
+
+int uart_stop_rx_isr(struct uart *uart)
+{
+  int err;
+
+  if ((err = uart_acquire_rx(uart))) {
+    return err;
+  }
+
+  LOG_DEBUG("");
+
+  uart_rx_isr_teardown(uart);
+
+  uart_release_rx(uart);
+
+  return 0;
+}
+#endif
+
 int uart_close_rx(struct uart *uart)
 {
   if (!xSemaphoreGiveRecursive(uart->rx_mutex)) {
@@ -492,6 +528,59 @@ error:
   return err;
 }
 
+#if UART_TX_ISR_SUPPORTED
+int uart_start_tx_isr(struct uart *uart, uart_tx_isr_func_t func, void *arg)
+{
+  int err;
+
+  if ((err = uart_acquire_tx(uart))) {
+    return err;
+  }
+
+  LOG_DEBUG("func=%p arg=%p", func, arg);
+
+  if ((err = uart_tx_flush(uart, portMAX_DELAY))) {
+    LOG_ERROR("uart_tx_flush");
+    goto error;
+  }
+
+  uart_tx_isr_setup(uart, func, arg);
+
+error:
+  uart_release_tx(uart);
+
+  return err;
+}
+
+void uart_trigger_tx_isr(struct uart *uart)
+{
+  uart_tx_isr_trigger(uart);
+}
+
+int uart_stop_tx_isr(struct uart *uart, TickType_t timeout)
+{
+  int err;
+
+  if ((err = uart_acquire_tx(uart))) {
+    return err;
+  }
+
+  LOG_DEBUG("");
+
+  uart_tx_isr_teardown(uart);
+
+  if ((err = uart_tx_flush(uart, timeout))) {
+    LOG_ERROR("uart_tx_flush");
+    goto error;
+  }
+
+error:
+  uart_release_tx(uart);
+
+  return err;
+}
+#endif
+
 int uart_close_tx(struct uart *uart, TickType_t timeout)
 {
   int err;
@@ -40,6 +40,28 @@ struct uart {
 #elif CONFIG_IDF_TARGET_ESP32
   TaskHandle_t tx_done_notify_task;
 #endif
+#if UART_RX_ISR_SUPPORTED
+  uart_rx_isr_func_t rx_isr_func;
+  void *rx_isr_arg;
+#endif
+#if UART_TX_ISR_SUPPORTED
+  uart_tx_isr_func_t tx_isr_func;
+  void *tx_isr_arg;
+
+  struct uart_tx_bulk {
+    const struct uart_tx_seg *seg, *end;
+    size_t offset;
+    bool seg_break;
+
+    // notified from ISR once the last segment has been written into the TX FIFO
+    TaskHandle_t notify_task;
+
+    // stats
+    int64_t start;
+    size_t bytes;
+    uint32_t isr_cycles;
+  } tx_bulk;
+#endif
 };
 
 /* pin.c */
@@ -74,6 +96,11 @@ enum uart_rx_event uart_rx_event(struct uart *uart);
 int uart_rx_read(struct uart *uart, void *buf, size_t size, TickType_t timeout);
 void uart_rx_abort(struct uart *uart);
 
+#if UART_RX_ISR_SUPPORTED
+void uart_rx_isr_setup(struct uart *uart, uart_rx_isr_func_t func, void *arg);
+void uart_rx_isr_teardown(struct uart *uart);
+#endif
+
 /* tx.c */
 int uart_tx_init(struct uart *uart, size_t tx_buffer_size);
 int uart_tx_setup(struct uart *uart, struct uart_options options);
@@ -88,6 +115,12 @@ int uart_tx_flush(struct uart *uart, TickType_t timeout);
 int uart_tx_break(struct uart *uart, unsigned bits);
 int uart_tx_mark(struct uart *uart, unsigned bits);
 
+#if UART_TX_ISR_SUPPORTED
+void uart_tx_isr_setup(struct uart *uart, uart_tx_isr_func_t func, void *arg);
+void uart_tx_isr_trigger(struct uart *uart);
+void uart_tx_isr_teardown(struct uart *uart);
+#endif
+
 /* intr.c */
 int uart_intr_setup(struct uart *uart);
 void uart_intr_teardown(struct uart *uart);
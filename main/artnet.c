@@ -11,6 +11,7 @@
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <lwip/sockets.h>
 
 #include <string.h>
 
@@ -79,13 +80,39 @@ static int build_artnet_metadata(struct artnet_metadata *metadata)
   return 0;
 }
 
+static int config_artnet_transmit(const struct artnet_config *config, struct artnet_transmit_options *options)
+{
+  options->enabled = config->transmit_enabled;
+  options->sync = config->transmit_sync;
+  options->keepalive_ticks = config->transmit_keepalive / portTICK_PERIOD_MS;
+
+  for (unsigned i = 0; i < config->transmit_address_count && i < ARTNET_TRANSMIT_ADDRESSES_MAX; i++) {
+    const char *address = config->transmit_addresses[i];
+    struct in_addr addr;
+
+    if (!address[0]) {
+      continue;
+    }
+
+    if (!inet_aton(address, &addr)) {
+      LOG_ERROR("invalid transmit_address=%s", address);
+      return -1;
+    }
+
+    memcpy(options->addresses[options->address_count++], &addr.s_addr, 4);
+  }
+
+  return 0;
+}
+
 int init_artnet()
 {
   const struct artnet_config *config = &artnet_config;
   struct artnet_options options = {
-    .port     = ARTNET_UDP_PORT,
-    .inputs   = count_artnet_inputs(),
-    .outputs  = count_artnet_outputs(),
+    .port         = ARTNET_UDP_PORT,
+    .recv_buffer  = config->recv_buffer,
+    .inputs       = count_artnet_inputs(),
+    .outputs      = count_artnet_outputs(),
   };
   int err;
 
@@ -99,10 +126,17 @@ int init_artnet()
     return err;
   }
 
-  LOG_INFO("options port=%u inputs=%u outputs=%u",
+  if ((err = config_artnet_transmit(config, &options.transmit))) {
+    LOG_ERROR("config_artnet_transmit");
+    return err;
+  }
+
+  LOG_INFO("options port=%u recv_buffer=%u inputs=%u outputs=%u transmit=%d",
     options.port,
+    options.recv_buffer,
     options.inputs,
-    options.outputs
+    options.outputs,
+    options.transmit.enabled
   );
   LOG_INFO("metadata ip_address=%u.%u.%u.%u", options.metadata.ip_address[0], options.metadata.ip_address[1], options.metadata.ip_address[2], options.metadata.ip_address[3]);
   LOG_INFO("metadata mac_address=%02x:%02x:%02x:%02x:%02x:%02x", options.metadata.mac_address[0], options.metadata.mac_address[1], options.metadata.mac_address[2], options.metadata.mac_address[3], options.metadata.mac_address[4], options.metadata.mac_address[5]);
@@ -116,7 +150,7 @@ int init_artnet()
 }
 
 // task
-xTaskHandle artnet_listen_task, artnet_inputs_task;
+xTaskHandle artnet_listen_task, artnet_poll_task, artnet_inputs_task;
 
 static void artnet_main_listen(void *ctx)
 {
@@ -130,6 +164,18 @@ static void artnet_main_listen(void *ctx)
   }
 }
 
+static void artnet_main_poll(void *ctx)
+{
+  struct artnet *artnet = ctx;
+  int err;
+
+  LOG_INFO("run network poll reply loop...");
+
+  if ((err = artnet_poll_main(artnet))) {
+    LOG_ERROR("artnet_poll_main");
+  }
+}
+
 static void artnet_main_inputs(void *ctx)
 {
   struct artnet *artnet = ctx;
@@ -153,6 +199,15 @@ int start_artnet()
     .handle     = &artnet_listen_task,
     .affinity   = ARTNET_LISTEN_TASK_AFFINITY,
   };
+  struct task_options poll_task_options = {
+    .main       = artnet_main_poll,
+    .name       = ARTNET_POLL_TASK_NAME,
+    .stack_size = ARTNET_POLL_TASK_STACK,
+    .arg        = artnet,
+    .priority   = ARTNET_POLL_TASK_PRIORITY,
+    .handle     = &artnet_poll_task,
+    .affinity   = ARTNET_POLL_TASK_AFFINITY,
+  };
   struct task_options input_task_options = {
     .main       = artnet_main_inputs,
     .name       = ARTNET_INPUTS_TASK_NAME,
@@ -175,6 +230,13 @@ int start_artnet()
     LOG_DEBUG("artnet listen task=%p", artnet_listen_task);
   }
 
+  if ((err = start_task(poll_task_options))) {
+    LOG_ERROR("start_task(artnet-poll)");
+    return -1;
+  } else {
+    LOG_DEBUG("artnet poll task=%p", artnet_poll_task);
+  }
+
   if (!artnet_get_inputs_enabled(artnet)) {
     LOG_DEBUG("no artnet inputs configured");
   } else if ((err = start_task(input_task_options))) {
@@ -137,14 +137,23 @@ int artnet_cmd_stats(int argc, char **argv, void *ctx)
   printf("Art-Net: \n");
 
   print_stats_timer  ("Network",  "receive",    &stats.recv);
+  print_stats_gauge  ("Network",  "backlog",    &stats.recv_backlog);
+  print_stats_counter("Network",  "overrun",    &stats.recv_overrun);
 
   print_stats_counter("Poll",     "received",   &stats.recv_poll);
+  print_stats_counter("Poll",     "dropped",    &stats.poll_drop);
+  print_stats_timer  ("Poll",     "reply",      &stats.poll);
+  print_stats_counter("Poll",     "rebuilt",    &stats.poll_build);
+  print_stats_counter("Poll",     "replies",    &stats.send_poll_reply);
   print_stats_counter("DMX",      "received",   &stats.recv_dmx);
   print_stats_counter("DMX",      "discarded",  &stats.dmx_discard);
+  print_stats_counter("DMX",      "missed",     &stats.dmx_miss);
   print_stats_counter("Sync",     "received",   &stats.recv_sync);
+  print_stats_counter("Sync",     "sent",       &stats.send_sync);
   print_stats_counter("Unknown",  "received",   &stats.recv_unknown);
   print_stats_counter("Recv",     "errors",     &stats.recv_error);
   print_stats_counter("Recv",     "invalid",    &stats.recv_invalid);
+  print_stats_counter("Send",     "errors",     &stats.send_error);
   print_stats_counter("Errors",   "",           &stats.errors);
 
   printf("\n");
@@ -164,6 +173,8 @@ int artnet_cmd_stats(int argc, char **argv, void *ctx)
 
     print_stats_counter("DMX",    "receive",  &input_stats.dmx_recv);
     print_stats_counter("Queue",  "overflow", &input_stats.queue_overflow);
+    print_stats_counter("DMX",    "send",     &input_stats.dmx_send);
+    print_stats_counter("DMX",    "skip",     &input_stats.dmx_skip);
 
     printf("\n");
   }
@@ -58,6 +58,14 @@ const struct configtab artnet_configtab[] = {
   { CONFIG_TYPE_BOOL, "enabled",
     .bool_type = { .value = &artnet_config.enabled, .default_value = ARTNET_CONFIG_ENABLED_DEFAULT },
   },
+  { CONFIG_TYPE_UINT16, "recv_buffer",
+    .description = (
+      "Socket receive buffer size in bytes, or 0 to use the lwIP default. "
+      "Each queued ArtDmx packet uses up to ~550 bytes: size for the number of universes received in each burst, "
+      "and check `artnet stats` for receive buffer overruns."
+    ),
+    .uint16_type = { .value = &artnet_config.recv_buffer },
+  },
   { CONFIG_TYPE_UINT16, "net",
     .description = "Base network address: 0-127",
     .migrated = true,
@@ -68,5 +76,22 @@ const struct configtab artnet_configtab[] = {
     .migrated = true,
     .uint16_type = { .max = ARTNET_SUBNET_MAX, .migrate_func = artnet_migrate_subnet },
   },
+  { CONFIG_TYPE_BOOL, "transmit_enabled",
+    .description = "Transmit Art-Net inputs (dmx-input) as ArtDmx on the network.",
+    .bool_type = { .value = &artnet_config.transmit_enabled },
+  },
+  { CONFIG_TYPE_STRING, "transmit_address",
+    .description = "Transmit to unicast or directed broadcast IPv4 addresses. Uses limited broadcast (255.255.255.255) if none.",
+    .count = &artnet_config.transmit_address_count, .size = ARTNET_TRANSMIT_ADDRESSES_MAX,
+    .string_type = { .value = (char *) artnet_config.transmit_addresses, .size = sizeof(artnet_config.transmit_addresses[0]) },
+  },
+  { CONFIG_TYPE_BOOL, "transmit_sync",
+    .description = "Transmit ArtSync after each batch of updated ArtDmx universes.",
+    .bool_type = { .value = &artnet_config.transmit_sync },
+  },
+  { CONFIG_TYPE_UINT16, "transmit_keepalive",
+    .description = "Only re-transmit unchanged ArtDmx universes at this interval (ms), or 0 to always transmit.",
+    .uint16_type = { .value = &artnet_config.transmit_keepalive, .default_value = ARTNET_CONFIG_TRANSMIT_KEEPALIVE_DEFAULT },
+  },
   {}
 };
@@ -1,7 +1,20 @@
 #pragma once
 
+#include <artnet.h>
+
+#define ARTNET_CONFIG_TRANSMIT_ADDRESS_SIZE 16
+#define ARTNET_CONFIG_TRANSMIT_KEEPALIVE_DEFAULT 1000
+
 struct artnet_config {
   bool enabled;
+
+  uint16_t recv_buffer;
+
+  bool transmit_enabled;
+  char transmit_addresses[ARTNET_TRANSMIT_ADDRESSES_MAX][ARTNET_CONFIG_TRANSMIT_ADDRESS_SIZE];
+  unsigned transmit_address_count;
+  bool transmit_sync;
+  uint16_t transmit_keepalive;
 };
 
 extern struct artnet_config artnet_config;
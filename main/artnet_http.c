@@ -172,6 +172,8 @@ static int artnet_api_write(struct json_writer *w, void *ctx)
           ||  JSON_WRITE_MEMBER_OBJECT(w, "recv_dmx_counter", artnet_api_write_object_status_counter_metrics(w, &status.metrics.recv_dmx_counter))
           ||  JSON_WRITE_MEMBER_OBJECT(w, "recv_sync_counter", artnet_api_write_object_status_counter_metrics(w, &status.metrics.recv_sync_counter))
           ||  JSON_WRITE_MEMBER_OBJECT(w, "dmx_discard_counter", artnet_api_write_object_status_counter_metrics(w, &status.metrics.dmx_discard_counter))
+          ||  JSON_WRITE_MEMBER_OBJECT(w, "dmx_miss_counter", artnet_api_write_object_status_counter_metrics(w, &status.metrics.dmx_miss_counter))
+          ||  JSON_WRITE_MEMBER_OBJECT(w, "recv_overrun_counter", artnet_api_write_object_status_counter_metrics(w, &status.metrics.recv_overrun_counter))
         )
     ||  JSON_WRITE_MEMBER_ARRAY(w, "inputs", artnet_api_write_inputs_array(w, artnet))
     ||  JSON_WRITE_MEMBER_ARRAY(w, "outputs", artnet_api_write_outputs_array(w, artnet, &status))
@@ -10,6 +10,8 @@ struct artnet_status_stats {
   struct stats_counter recv_dmx_counter;
   struct stats_counter recv_sync_counter;
   struct stats_counter dmx_discard_counter;
+  struct stats_counter dmx_miss_counter;
+  struct stats_counter recv_overrun_counter;
 
   struct artnet_status_output_stats {
     struct stats_counter dmx_counter;
@@ -26,6 +28,8 @@ struct artnet_status_metrics {
   struct stats_counter_metrics recv_dmx_counter;
   struct stats_counter_metrics recv_sync_counter;
   struct stats_counter_metrics dmx_discard_counter;
+  struct stats_counter_metrics dmx_miss_counter;
+  struct stats_counter_metrics recv_overrun_counter;
 
   struct artnet_status_output_metrics {
     struct stats_counter_metrics dmx_counter;
@@ -43,3 +47,6 @@ struct artnet_status {
 };
 
 struct artnet_status get_artnet_status(struct artnet *artnet);
+
+/* Metrics averaged against the caller's own baseline, instead of the shared API baseline */
+struct artnet_status get_artnet_status_metrics(struct artnet *artnet, struct artnet_status_stats *baseline, struct artnet_status_metrics *metrics);
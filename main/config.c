@@ -8,6 +8,7 @@
 #include "http.h"
 #include "i2c.h"
 #include "leds.h"
+#include "tasks.h"
 #include "wifi.h"
 
 #include <config.h>
@@ -32,6 +33,12 @@ const struct configmod config_modules[] = {
     .tables = i2c_gpio_configtabs,
     .tables_count = I2C_GPIO_COUNT,
   },
+#endif
+#if TASKS_AFFINITY_SUPPORTED
+  { "tasks",
+    .description = "Task scheduling for dual-core CPUs",
+    .table = tasks_configtab,
+  },
 #endif
   { "wifi",
     .description = (
@@ -119,6 +126,14 @@ void disable_config()
 
 int load_config()
 {
+  int err;
+
+  if ((err = config_load_cache(&config, CONFIG_BOOT_FILE)) < 0) {
+    LOG_WARN("config_load_cache(%s)", CONFIG_BOOT_FILE);
+  } else if (!err) {
+    return 0;
+  }
+
   if (config_load(&config, CONFIG_BOOT_FILE)) {
     if (errno == ENOENT) {
       LOG_WARN("spiffs %s file at %s not found", CONFIG_VFS_PATH, CONFIG_BOOT_FILE);
@@ -183,6 +198,11 @@ int boot_config()
 
       config_boot(&config);
 
+      // speed up next boot, after outputs have started
+      if (!config.cached && config_save_cache(&config, CONFIG_BOOT_FILE)) {
+        LOG_WARN("config_save_cache(%s)", CONFIG_BOOT_FILE);
+      }
+
       break;
 
     case CONFIG_STATE_ERROR:
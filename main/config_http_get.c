@@ -311,6 +311,7 @@ static int config_api_write_config(struct json_writer *w, void *ctx)
   return JSON_WRITE_OBJECT(w,
         JSON_WRITE_MEMBER_STRING(w, "filename", config->filename)
     ||  JSON_WRITE_MEMBER_STRING(w, "state", config_state_str(config->state))
+    ||  JSON_WRITE_MEMBER_BOOL(w, "cached", config->cached)
     ||  JSON_WRITE_MEMBER_UINT(w, "tick", config->tick)
     ||  JSON_WRITE_MEMBER_UINT(w, "tick_ms", TICK_MS(tick, config->tick))
     ||  JSON_WRITE_MEMBER_ARRAY(w, "modules", config_api_write_config_modules(w, config))
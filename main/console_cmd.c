@@ -5,6 +5,7 @@
 #include "config.h"
 #include "dmx.h"
 #include "eth.h"
+#include "i2c.h"
 #include "leds.h"
 #include "log.h"
 #include "sdcard.h"
@@ -50,6 +51,11 @@ const struct cmd console_cli_commands[] = {
   { "config",       .describe = "Configuration",
       .subcommands = &config_cmdtab,
   },
+#if CONFIG_I2C_GPIO_ENABLED
+  { "i2c-gpio",     .describe = "I2C GPIO",
+      .subcommands = &i2c_gpio_cmdtab,
+  },
+#endif
 #if CONFIG_USB_PD_SINK_ENABLED
   { "usb-pd",       .describe = "USB-PD Sink",
       .subcommands = &usb_pd_cmdtab,
@@ -2,8 +2,12 @@
 
 #include <cmd.h>
 #include <config.h>
+#include <uart.h>
 
-#define DMX_OUTPUT_COUNT 2
+#define DMX_OUTPUT_COUNT 3
+
+// outputs on a dedicated UART need a mapped TX pin
+#define DMX_OUTPUT_UART_SUPPORTED UART_IO_PINS_SUPPORTED
 
 extern const struct configtab dmx_uart_configtab[];
 extern const struct configtab dmx_input_configtab[];
@@ -45,6 +45,12 @@ int dmx_cmd_info(int argc, char **argv, void *ctx)
     printf("dmx-output%d:\n", i + 1);
     printf("\t%-20s: %s\n", "Enabled", output_config->enabled ? "true" : "false");
     printf("\t%-20s: %s\n", "Initialized", output_state->dmx_output ? "true" : "false");
+  #if DMX_OUTPUT_UART_SUPPORTED
+    printf("\t%-20s: %s\n", "UART", output_state->uart ? (config_enum_to_string(dmx_output_uart_enum, output_config->uart_port) ?: "?") : "dmx-uart");
+  #endif
+  #if DMX_OUTPUT_REFRESH_SUPPORTED
+    printf("\t%-20s: %s\n", "Refresh", output_state->refresh_enabled ? "true" : "false");
+  #endif
 
     if (output_state->artnet_output) {
       const struct artnet_output_options *output_options = artnet_output_options(output_state->artnet_output);
@@ -257,6 +263,10 @@ int dmx_cmd_stats(int argc, char **argv, void *ctx)
     print_stats_counter("DMX",    "unknown",  &stats.cmd_unknown);
     printf("\t\n");
     print_stats_gauge(  "Data",   "len",      &stats.data_len);
+    printf("\t\n");
+    print_stats_counter("Frame",  "drop",     &stats.frame_drop);
+    print_stats_gauge(  "Frame",  "rate",     &stats.frame_rate);
+    print_stats_gauge(  "Frame",  "slots",    &stats.frame_slots);
     printf("\n");
   }
 
@@ -276,10 +286,21 @@ int dmx_cmd_stats(int argc, char **argv, void *ctx)
     print_stats_timer  ("UART",   "TX",       &stats.uart_tx);
     printf("\t\n");
     print_stats_counter("TX",     "error",    &stats.tx_error);
+    print_stats_counter("TX",     "refresh",  &stats.tx_refresh);
     printf("\t\n");
     print_stats_counter("DMX",    "dimmer",   &stats.cmd_dimmer);
     printf("\t\n");
     print_stats_gauge(  "Data",   "len",      &stats.data_len);
+  #if DMX_OUTPUT_BULK_SUPPORTED
+    print_stats_gauge(  "TX",     "bytes/s",  &stats.tx_rate);
+    print_stats_gauge(  "TX",     "ISR cycles/byte", &stats.tx_isr);
+  #endif
+  #if DMX_OUTPUT_REFRESH_SUPPORTED
+    printf("\t\n");
+    print_stats_gauge(  "Refresh", "frames/s", &stats.refresh_rate);
+    print_stats_gauge(  "Refresh", "frame us", &stats.refresh_frame);
+    print_stats_gauge(  "Refresh", "jitter us", &stats.refresh_jitter);
+  #endif
     printf("\n");
   }
 
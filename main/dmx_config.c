@@ -39,6 +39,20 @@ const struct config_enum dmx_uart_enum[] = {
 # define DMX_UART_CONFIG_PORT_DEFAULT_VALUE -1
 #endif
 
+#if DMX_OUTPUT_UART_SUPPORTED
+// UART0 is left for the console and [dmx-uart]
+const struct config_enum dmx_output_uart_enum[] = {
+  { "",           .value = -1      },
+#if defined(UART_1) && CONFIG_ESP_CONSOLE_UART_NUM != 1
+  { "UART1",      .value = UART_1  },
+#endif
+#if defined(UART_2) && CONFIG_ESP_CONSOLE_UART_NUM != 2
+  { "UART2",      .value = UART_2  },
+#endif
+ {}
+};
+#endif
+
 const struct config_enum dmx_gpio_mode_enum[] = {
   { "",     .value = DMX_GPIO_MODE_DISABLED  },
   { "LOW",  .value = DMX_GPIO_MODE_LOW       },
@@ -122,7 +136,14 @@ const struct configtab dmx_input_configtab[] = {
 #undef DMX_OUTPUT_CONFIGTAB
 #undef DMX_OUTPUT_CONFIG
 
+#define DMX_OUTPUT_CONFIGTAB dmx_output_configtab2
+#define DMX_OUTPUT_CONFIG dmx_output_configs[2]
+#include "dmx_output_configtab.i"
+#undef DMX_OUTPUT_CONFIGTAB
+#undef DMX_OUTPUT_CONFIG
+
 const struct configtab *dmx_output_configtabs[DMX_OUTPUT_COUNT] = {
   dmx_output_configtab0,
   dmx_output_configtab1,
+  dmx_output_configtab2,
 };
@@ -3,10 +3,14 @@
 #include "dmx.h"
 
 #include <config.h>
+#include <dmx_output.h>
 #include <dmx_uart.h>
 
 #define DMX_GPIO_COUNT 4
 
+// full 512 slot frames at 250kbaud
+#define DMX_OUTPUT_REFRESH_RATE_MAX 44
+
 enum dmx_gpio_mode {
   DMX_GPIO_MODE_DISABLED  = -1,
   DMX_GPIO_MODE_LOW       = 0,
@@ -14,6 +18,9 @@ enum dmx_gpio_mode {
 };
 
 extern const struct config_enum dmx_gpio_mode_enum[];
+#if DMX_OUTPUT_UART_SUPPORTED
+extern const struct config_enum dmx_output_uart_enum[];
+#endif
 
 struct dmx_uart_config {
   int port;
@@ -46,6 +53,16 @@ struct dmx_output_config {
   uint16_t gpio_pins[DMX_GPIO_COUNT];
   unsigned gpio_count;
 
+#if DMX_OUTPUT_UART_SUPPORTED
+  int uart_port;
+  uint16_t uart_tx_pin;
+#endif
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  bool refresh_enabled;
+  uint16_t refresh_rate;
+#endif
+
   bool artnet_enabled;
   uint16_t artnet_net;
   uint16_t artnet_subnet;
@@ -27,10 +27,21 @@ int init_dmx_input()
     return -1;
   }
 
+#if DMX_INPUT_ISR_SUPPORTED
+  // double-buffered with artnet_dmx
+  if (!(state->artnet_dmx_alt = calloc(1, sizeof(*state->artnet_dmx_alt)))) {
+    LOG_ERROR("calloc: artnet_dmx_alt");
+    return -1;
+  }
+#endif
+
   // dmx input
   struct dmx_input_options options = {
     .data          = state->artnet_dmx->data,
     .size          = sizeof(state->artnet_dmx->data),
+#if DMX_INPUT_ISR_SUPPORTED
+    .data_alt      = state->artnet_dmx_alt->data,
+#endif
   };
 
   LOG_INFO("dmx-input: enabled data=%p size=%u", options.data, options.size);
@@ -71,8 +82,21 @@ int init_dmx_input()
   return 0;
 }
 
+static struct artnet_dmx *dmx_input_artnet_dmx(struct dmx_input_state *state, const struct dmx_input_frame *frame)
+{
+#if DMX_INPUT_ISR_SUPPORTED
+  if (frame->data == state->artnet_dmx_alt->data) {
+    return state->artnet_dmx_alt;
+  }
+#endif
+
+  return state->artnet_dmx;
+}
+
 int run_dmx_input(struct dmx_input_state *state)
 {
+  struct dmx_input_frame frame;
+  struct artnet_dmx *artnet_dmx;
   int read;
   int err;
 
@@ -86,22 +110,23 @@ int run_dmx_input(struct dmx_input_state *state)
   LOG_INFO("start read loop");
 
   for (;;) {
-    if ((read = dmx_input_read(state->dmx_input)) < 0) {
-      LOG_DEBUG("dmx_input_read");
+    if ((read = dmx_input_read_frame(state->dmx_input, &frame)) < 0) {
+      LOG_DEBUG("dmx_input_read_frame");
       continue;
     } else if (read) {
-      LOG_DEBUG("dmx_input_read: len=%d", read);
+      LOG_DEBUG("dmx_input_read_frame: len=%d slots=%u", read, frame.slots);
 
-      state->artnet_dmx->len = read;
+      artnet_dmx = dmx_input_artnet_dmx(state, &frame);
+      artnet_dmx->len = read;
     } else {
-      LOG_INFO("dmx_input_read: stopped");
+      LOG_INFO("dmx_input_read_frame: stopped");
       break;
     }
 
     user_activity(USER_ACTIVITY_DMX_INPUT);
 
     if (state->artnet_input) {
-      artnet_input_dmx(state->artnet_input, state->artnet_dmx);
+      artnet_input_dmx(state->artnet_input, artnet_dmx);
     }
   }
 
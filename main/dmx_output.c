@@ -1,6 +1,7 @@
 #include "dmx.h"
 #include "dmx_config.h"
 #include "dmx_state.h"
+#include "dmx_artnet.h"
 #include "artnet_state.h"
 #include "user.h"
 #include "tasks.h"
@@ -8,9 +9,76 @@
 #include <artnet.h>
 #include <dmx_output.h>
 #include <logging.h>
+#include <system.h>
 
 struct dmx_output_state dmx_output_states[DMX_OUTPUT_COUNT];
 
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+// outputs refreshing at the same rate share a timer, aligning their frames across UARTs
+static struct dmx_output_refresh_timer {
+  unsigned rate;
+  struct dmx_output_timer *timer;
+} dmx_output_refresh_timers[DMX_OUTPUT_COUNT];
+
+// outputs sharing the dmx_uart
+static unsigned count_dmx_uart_outputs()
+{
+  unsigned count = 0;
+
+  for (int i = 0; i < DMX_OUTPUT_COUNT; i++) {
+    const struct dmx_output_config *config = &dmx_output_configs[i];
+
+    if (!config->enabled) {
+      continue;
+    }
+
+  #if DMX_OUTPUT_UART_SUPPORTED
+    if (config->uart_port >= 0) {
+      continue;
+    }
+  #endif
+
+    count++;
+  }
+
+  return count;
+}
+
+static int init_dmx_output_refresh_timer(struct dmx_output_state *state, unsigned rate)
+{
+  struct dmx_output_refresh_timer *refresh_timer = NULL;
+  int err;
+
+  if (!rate) {
+    // back-to-back
+    state->refresh_timer = NULL;
+    return 0;
+  }
+
+  for (int i = 0; i < DMX_OUTPUT_COUNT; i++) {
+    if (dmx_output_refresh_timers[i].timer && dmx_output_refresh_timers[i].rate != rate) {
+      continue;
+    }
+
+    refresh_timer = &dmx_output_refresh_timers[i];
+    break;
+  }
+
+  if (!refresh_timer->timer) {
+    if ((err = dmx_output_timer_new(&refresh_timer->timer, rate))) {
+      LOG_ERROR("dmx_output_timer_new");
+      return err;
+    }
+
+    refresh_timer->rate = rate;
+  }
+
+  state->refresh_timer = refresh_timer->timer;
+
+  return 0;
+}
+#endif
+
 int init_dmx_output(struct dmx_output_state *state, int index, const struct dmx_output_config *config)
 {
   int err;
@@ -37,6 +105,43 @@ int init_dmx_output(struct dmx_output_state *state, int index, const struct dmx_
     return err;
   }
 
+#if DMX_OUTPUT_UART_SUPPORTED
+  if ((err = init_dmx_output_uart(state, config))) {
+    LOG_ERROR("dmx-output%d: init_dmx_output_uart", index + 1);
+    return err;
+  }
+#endif
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  if (!config->refresh_enabled) {
+    // open/write/close UART per packet
+#if DMX_OUTPUT_UART_SUPPORTED
+  } else if (state->uart) {
+    // the refresh ISR holds the dedicated UART TX open
+    LOG_INFO("dmx-output%d: refresh rate=%u on dedicated uart", index + 1, config->refresh_rate);
+
+    state->refresh_enabled = true;
+    state->refresh_rate = config->refresh_rate;
+#endif
+  } else if (count_dmx_uart_outputs() > 1) {
+    // the refresh ISR holds the shared UART TX open
+    LOG_WARN("dmx-output%d: refresh is not supported with multiple outputs on the shared dmx-uart", index + 1);
+  } else if ((dmx_uart_config.port & UART_PORT_MASK) == UART_0) {
+    // the refresh ISR holds the UART TX open, which would block release_dmx_uart0()
+    LOG_WARN("dmx-output%d: refresh is not supported on UART0", index + 1);
+  } else {
+    LOG_INFO("dmx-output%d: refresh rate=%u", index + 1, config->refresh_rate);
+
+    state->refresh_enabled = true;
+    state->refresh_rate = config->refresh_rate;
+  }
+
+  if (state->refresh_enabled && (err = init_dmx_output_refresh_timer(state, state->refresh_rate))) {
+    LOG_ERROR("dmx-output%d: init_dmx_output_refresh_timer", index + 1);
+    return err;
+  }
+#endif
+
   // artnet
   if (config->artnet_enabled) {
     if (!(state->artnet_dmx = calloc(1, sizeof(*state->artnet_dmx)))) {
@@ -65,6 +170,35 @@ int init_dmx_outputs()
   return 0;
 }
 
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+static int output_dmx_refresh(struct dmx_output_state *state, void *data, size_t len)
+{
+  int err;
+
+  if (state->refresh_started) {
+    // UART remains open
+  } else if ((err = start_dmx_output_uart(state))) {
+    if (err > 0) {
+      LOG_WARN("dmx_output_start: UART not setup, DMX not running");
+      return 1;
+    } else {
+      LOG_ERROR("dmx_output_start");
+      return err;
+    }
+  } else {
+    state->refresh_started = true;
+  }
+
+  // only updates the next refresh frame
+  if ((err = dmx_output_write(state->dmx_output, DMX_CMD_DIMMER, data, len)) < 0) {
+    LOG_ERROR("dmx_output_write");
+    return err;
+  }
+
+  return 0;
+}
+#endif
+
 int output_dmx(struct dmx_output_state *state, void *data, size_t len)
 {
   int err;
@@ -76,7 +210,13 @@ int output_dmx(struct dmx_output_state *state, void *data, size_t len)
 
   user_activity(USER_ACTIVITY_DMX_OUTPUT);
 
-  if ((err = open_dmx_output_uart(state->dmx_output))) {
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  if (state->refresh_enabled) {
+    return output_dmx_refresh(state, data, len);
+  }
+#endif
+
+  if ((err = open_dmx_output_uart(state))) {
     if (err > 0) {
       LOG_WARN("dmx_output_open: UART not setup, DMX not running");
       return 1;
@@ -113,6 +253,8 @@ void dmx_output_main(void *ctx)
       LOG_WARN("dmx-output%d: output_dmx", state->index + 1);
       continue;
     }
+
+    system_boot_frame();
   }
 }
 
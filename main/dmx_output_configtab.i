@@ -22,6 +22,38 @@ const struct configtab DMX_OUTPUT_CONFIGTAB[] = {
   .uint16_type = { .value = DMX_OUTPUT_CONFIG.gpio_pins, .max = GPIO_PIN_MAX },
 },
 
+#if DMX_OUTPUT_UART_SUPPORTED
+ { CONFIG_TYPE_ENUM, "uart_port",
+   .description = (
+     "Output on a dedicated UART, instead of sharing the [dmx-uart] port with other outputs. "
+     "Outputs on dedicated UARTs are written concurrently, and support refresh with multiple outputs enabled."
+   ),
+   .enum_type = { .value = &DMX_OUTPUT_CONFIG.uart_port, .values = dmx_output_uart_enum, .default_value = -1 },
+ },
+ { CONFIG_TYPE_UINT16, "uart_tx_pin",
+   .description = (
+     "Output dedicated UART TX data to GPIO pin, required with uart_port. "
+     "The UART1/UART2 iomux TX pins are used by the SPI flash/PSRAM, so 0 = iomux is not supported."
+   ),
+   .uint16_type = { .value = &DMX_OUTPUT_CONFIG.uart_tx_pin, .max = (GPIO_NUM_MAX - 1), .default_value = 0 },
+ },
+#endif
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+ { CONFIG_TYPE_BOOL, "refresh_enabled",
+   .description = (
+     "Continuously refresh the DMX output from the UART interrupt handler, repeating the most recent Art-Net frame. "
+     "Only supported with a single enabled DMX output, unless using a dedicated uart_port. "
+     "Outputs refreshing at the same rate start each frame at the same time."
+   ),
+   .bool_type = { .value = &DMX_OUTPUT_CONFIG.refresh_enabled },
+ },
+ { CONFIG_TYPE_UINT16, "refresh_rate",
+   .description = "Continuous refresh rate in Hz, or 0 to refresh back-to-back at the maximum rate.",
+   .uint16_type = { .value = &DMX_OUTPUT_CONFIG.refresh_rate, .max = DMX_OUTPUT_REFRESH_RATE_MAX },
+ },
+#endif
+
  { CONFIG_TYPE_BOOL, "artnet_enabled",
    .bool_type = { .value = &DMX_OUTPUT_CONFIG.artnet_enabled },
  },
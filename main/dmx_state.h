@@ -28,7 +28,13 @@ int init_dmx_uart();
 int start_dmx_uart();
 
 int open_dmx_input_uart(struct dmx_input *input);
-int open_dmx_output_uart(struct dmx_output *output);
+#if DMX_OUTPUT_UART_SUPPORTED
+int init_dmx_output_uart(struct dmx_output_state *state, const struct dmx_output_config *config);
+#endif
+int open_dmx_output_uart(struct dmx_output_state *state);
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+int start_dmx_output_uart(struct dmx_output_state *state);
+#endif
 
 bool query_dmx_uart0();
 
@@ -47,6 +53,9 @@ struct dmx_input_state {
 
   struct artnet_input *artnet_input;
   struct artnet_dmx *artnet_dmx;
+#if DMX_INPUT_ISR_SUPPORTED
+  struct artnet_dmx *artnet_dmx_alt;
+#endif
 };
 
 extern struct dmx_input_state dmx_input_state;
@@ -63,6 +72,19 @@ struct dmx_output_state {
 
   struct dmx_output *dmx_output;
 
+#if DMX_OUTPUT_UART_SUPPORTED
+  // dedicated UART, or NULL to use the shared dmx_uart
+  struct uart *uart;
+#endif
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+  bool refresh_enabled, refresh_started;
+  unsigned refresh_rate;
+
+  // shared by outputs with the same refresh rate, or NULL for back-to-back refresh
+  struct dmx_output_timer *refresh_timer;
+#endif
+
   xTaskHandle artnet_task;
   struct artnet_dmx *artnet_dmx;
   struct artnet_output *artnet_output;
@@ -3,6 +3,7 @@
 #include "dmx_state.h"
 #include "dev_mutex.h"
 
+#include <dmx_input.h>
 #include <dmx_uart.h>
 #include <logging.h>
 
@@ -27,7 +28,11 @@ int init_dmx_uart()
 
   // setup
   uart_port_t uart_port = uart_config->port;
+#if DMX_INPUT_ISR_SUPPORTED
+  size_t rx_buffer_size = 0; // dmx-input reads frames directly from the UART ISR
+#else
   size_t rx_buffer_size = input_enabled ? DMX_UART_RX_BUFFER_SIZE : 0;
+#endif
   size_t tx_buffer_size = outputs_enabled ? DMX_UART_TX_BUFFER_SIZE : 0;
 
   // TODO: fully configurable IO pins?
@@ -123,15 +128,96 @@ int open_dmx_input_uart(struct dmx_input *input)
   return dmx_input_open(input, dmx_uart);
 }
 
-int open_dmx_output_uart(struct dmx_output *output)
+#if DMX_OUTPUT_UART_SUPPORTED
+int init_dmx_output_uart(struct dmx_output_state *state, const struct dmx_output_config *config)
 {
-  if (!dmx_uart) {
+  struct dmx_uart_options options = {
+    .mtbp_min = DMX_UART_MTBP_MIN,
+    .rx_pin   = -1, // disabled
+    .tx_pin   = config->uart_tx_pin,
+  };
+  uart_port_t uart_port = config->uart_port;
+  int err;
+
+  if (config->uart_port < 0) {
+    return 0;
+  }
+
+  if (!config->uart_tx_pin) {
+    // tx_pin=0 would select the iomux pin, which is a SPI flash/PSRAM pin for UART1/UART2
+    LOG_ERROR("dmx-output%d: uart%d requires uart_tx_pin", state->index + 1, config->uart_port);
+    return -1;
+  }
+
+  if (dmx_uart_config.port >= 0 && (dmx_uart_config.port & UART_PORT_MASK) == config->uart_port) {
+    LOG_ERROR("dmx-output%d: uart%d is already used by dmx-uart", state->index + 1, config->uart_port);
+    return -1;
+  }
+
+  for (int i = 0; i < state->index; i++) {
+    if (dmx_output_configs[i].enabled && dmx_output_configs[i].uart_port == config->uart_port) {
+      LOG_ERROR("dmx-output%d: uart%d is already used by dmx-output%d", state->index + 1, config->uart_port, i + 1);
+      return -1;
+    }
+  }
+
+#ifdef UART_TXONLY_BIT
+  uart_port |= UART_TXONLY_BIT;
+#endif
+
+  LOG_INFO("dmx-output%d: uart%d configured with tx_pin=%d", state->index + 1, config->uart_port, options.tx_pin);
+
+  if ((err = uart_new(&state->uart, uart_port, 0, DMX_UART_TX_BUFFER_SIZE))) {
+    LOG_ERROR("uart_new(port=%d)", uart_port);
+    return err;
+  }
+
+  // not shared with any other UART user, can be setup immediately
+  if ((err = dmx_uart_setup(state->uart, options))) {
+    LOG_ERROR("dmx_uart_setup");
+    return err;
+  }
+
+  return 0;
+}
+#endif
+
+static struct uart *dmx_output_uart(struct dmx_output_state *state)
+{
+#if DMX_OUTPUT_UART_SUPPORTED
+  if (state->uart) {
+    return state->uart;
+  }
+#endif
+
+  return dmx_uart;
+}
+
+int open_dmx_output_uart(struct dmx_output_state *state)
+{
+  struct uart *uart = dmx_output_uart(state);
+
+  if (!uart) {
+    LOG_INFO("disabled");
+    return 1;
+  }
+
+  return dmx_output_open(state->dmx_output, uart);
+}
+
+#if DMX_OUTPUT_REFRESH_SUPPORTED
+int start_dmx_output_uart(struct dmx_output_state *state)
+{
+  struct uart *uart = dmx_output_uart(state);
+
+  if (!uart) {
     LOG_INFO("disabled");
     return 1;
   }
 
-  return dmx_output_open(output, dmx_uart);
+  return dmx_output_start(state->dmx_output, uart, state->refresh_timer);
 }
+#endif
 
 bool query_dmx_uart0()
 {
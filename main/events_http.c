@@ -0,0 +1,295 @@
+#include "http.h"
+#include "http_routes.h"
+#include "artnet_state.h"
+#include "artnet_status.h"
+#include "leds.h"
+#include "leds_config.h"
+#include "leds_state.h"
+#include "leds_status.h"
+
+#include <artnet.h>
+#include <logging.h>
+#include <json.h>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EVENTS_INTERVAL_DEFAULT 1000 // ms
+#define EVENTS_INTERVAL_MIN 100 // ms
+#define EVENTS_INTERVAL_MAX 60000 // ms
+
+#define EVENTS_KEY_SIZE 64
+
+/* Last sent metrics, for deltas */
+struct events_metrics {
+  struct artnet_status_metrics artnet;
+  struct leds_status_timer_metrics leds[LEDS_COUNT];
+
+  // separate from the API metrics baselines, which would otherwise be reset by every event
+  struct artnet_status_stats artnet_baseline;
+  struct artnet_status_metrics artnet_average;
+  struct leds_status_timers leds_baseline[LEDS_COUNT];
+  struct leds_status_timer_metrics leds_average[LEDS_COUNT];
+};
+
+// only one event stream at a time, to keep a server task free for other requests
+// protected by http_server_lock()
+static bool events_streaming;
+static struct events_metrics events_metrics;
+
+struct events_query {
+  unsigned interval;
+};
+
+static int events_api_query(struct http_request *request, struct events_query *query)
+{
+  char *key, *value;
+  int err;
+
+  while (!(err = http_request_query(request, &key, &value))) {
+    if (strcmp(key, "interval") == 0) {
+      char *end;
+
+      query->interval = strtoul(value, &end, 10);
+
+      if (*end || query->interval < EVENTS_INTERVAL_MIN || query->interval > EVENTS_INTERVAL_MAX) {
+        LOG_WARN("invalid interval=%s", value);
+        return HTTP_UNPROCESSABLE_ENTITY;
+      }
+    }
+  }
+
+  if (err < 0) {
+    LOG_WARN("http_request_query");
+    return err;
+  }
+
+  return 0;
+}
+
+/* Write changed timer metrics, ignoring interval-only changes */
+static int events_write_timer_metrics(struct json_writer *w, const char *prefix, const char *name, const struct stats_timer_metrics *metrics, struct stats_timer_metrics *sent, bool force)
+{
+  char key[EVENTS_KEY_SIZE];
+
+  if (!force && metrics->rate == sent->rate && metrics->util == sent->util) {
+    return 0;
+  }
+
+  *sent = *metrics;
+
+  snprintf(key, sizeof(key), "%s.%s", prefix, name);
+
+  return JSON_WRITE_MEMBER_OBJECT(w, key,
+        JSON_WRITE_MEMBER_FLOAT(w, "interval", metrics->interval)
+    ||  JSON_WRITE_MEMBER_FLOAT(w, "rate", metrics->rate)
+    ||  JSON_WRITE_MEMBER_FLOAT(w, "util", metrics->util)
+  );
+}
+
+/* Write changed counter metrics, ignoring interval-only changes */
+static int events_write_counter_metrics(struct json_writer *w, const char *prefix, const char *name, const struct stats_counter_metrics *metrics, struct stats_counter_metrics *sent, bool force)
+{
+  char key[EVENTS_KEY_SIZE];
+
+  if (!force && metrics->rate == sent->rate) {
+    return 0;
+  }
+
+  *sent = *metrics;
+
+  snprintf(key, sizeof(key), "%s.%s", prefix, name);
+
+  return JSON_WRITE_MEMBER_OBJECT(w, key,
+        JSON_WRITE_MEMBER_FLOAT(w, "interval", metrics->interval)
+    ||  JSON_WRITE_MEMBER_FLOAT(w, "rate", metrics->rate)
+  );
+}
+
+static int events_write_artnet_output_metrics(struct json_writer *w, unsigned index, const struct artnet_status_output_metrics *metrics, struct artnet_status_output_metrics *sent, bool force)
+{
+  char prefix[EVENTS_KEY_SIZE];
+
+  snprintf(prefix, sizeof(prefix), "artnet_outputs.%u.metrics", index);
+
+  return (
+        events_write_counter_metrics(w, prefix, "dmx_counter", &metrics->dmx_counter, &sent->dmx_counter, force)
+    ||  events_write_counter_metrics(w, prefix, "seq_miss_counter", &metrics->seq_miss_counter, &sent->seq_miss_counter, force)
+    ||  events_write_counter_metrics(w, prefix, "seq_drop_counter", &metrics->seq_drop_counter, &sent->seq_drop_counter, force)
+    ||  events_write_counter_metrics(w, prefix, "update_counter", &metrics->update_counter, &sent->update_counter, force)
+    ||  events_write_counter_metrics(w, prefix, "overflow_counter", &metrics->overflow_counter, &sent->overflow_counter, force)
+  );
+}
+
+static int events_write_artnet_metrics(struct json_writer *w, bool force)
+{
+  struct artnet_status status = get_artnet_status_metrics(artnet, &events_metrics.artnet_baseline, &events_metrics.artnet_average);
+  struct artnet_status_metrics *sent = &events_metrics.artnet;
+  unsigned output_count = artnet_get_output_count(artnet);
+  int err;
+
+  if ((err = (
+        events_write_timer_metrics(w, "artnet.metrics", "recv_timer", &status.metrics.recv_timer, &sent->recv_timer, force)
+    ||  events_write_counter_metrics(w, "artnet.metrics", "recv_poll_counter", &status.metrics.recv_poll_counter, &sent->recv_poll_counter, force)
+    ||  events_write_counter_metrics(w, "artnet.metrics", "recv_dmx_counter", &status.metrics.recv_dmx_counter, &sent->recv_dmx_counter, force)
+    ||  events_write_counter_metrics(w, "artnet.metrics", "recv_sync_counter", &status.metrics.recv_sync_counter, &sent->recv_sync_counter, force)
+    ||  events_write_counter_metrics(w, "artnet.metrics", "dmx_discard_counter", &status.metrics.dmx_discard_counter, &sent->dmx_discard_counter, force)
+  ))) {
+    return err;
+  }
+
+  for (unsigned i = 0; i < output_count && i < ARTNET_OUTPUTS_MAX; i++) {
+    if ((err = events_write_artnet_output_metrics(w, i, &status.metrics.outputs[i], &sent->outputs[i], force))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+static int events_write_leds_metrics(struct json_writer *w, struct leds_state *state, bool force)
+{
+  struct leds_status_timer_metrics *sent = &events_metrics.leds[state->index];
+  struct leds_status status;
+  char prefix[EVENTS_KEY_SIZE];
+
+  get_leds_status_metrics(state, &status, &events_metrics.leds_baseline[state->index], &events_metrics.leds_average[state->index]);
+
+  snprintf(prefix, sizeof(prefix), "leds.leds%u.status.metrics", state->index + 1);
+
+  return (
+        events_write_timer_metrics(w, prefix, "task", &status.metrics.task, &sent->task, force)
+    ||  events_write_timer_metrics(w, prefix, "interface", &status.metrics.interface, &sent->interface, force)
+  );
+}
+
+/* Write one flat object of changed metrics, keyed by the path within the matching API objects */
+static int events_write_metrics(struct json_writer *w, bool force)
+{
+  int err;
+
+  if (artnet && (err = events_write_artnet_metrics(w, force))) {
+    return err;
+  }
+
+  for (unsigned i = 0; i < LEDS_COUNT; i++) {
+    struct leds_state *state = &leds_states[i];
+
+    if (!state->config || !state->config->enabled || !state->leds) {
+      continue;
+    }
+
+    if ((err = events_write_leds_metrics(w, state, force))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+static int events_send_metrics(FILE *file, bool force)
+{
+  struct json_writer json_writer;
+
+  if (fputs("event: metrics\ndata: ", file) < 0) {
+    LOG_DEBUG("fputs: %s", strerror(errno));
+    return -1;
+  }
+
+  if (json_writer_init(&json_writer, file)) {
+    LOG_ERROR("json_writer_init");
+    return -1;
+  }
+
+  if (JSON_WRITE_OBJECT(&json_writer, events_write_metrics(&json_writer, force))) {
+    LOG_DEBUG("events_write_metrics");
+    return -1;
+  }
+
+  if (fputs("\n\n", file) < 0) {
+    LOG_DEBUG("fputs: %s", strerror(errno));
+    return -1;
+  }
+
+  return 0;
+}
+
+int events_api_handler(struct http_request *request, struct http_response *response, void *ctx)
+{
+  struct events_query query = { .interval = EVENTS_INTERVAL_DEFAULT };
+  FILE *file;
+  int err;
+
+  if ((err = http_request_headers(request, NULL))) {
+    LOG_WARN("http_request_headers");
+    return err;
+  }
+
+  if ((err = events_api_query(request, &query))) {
+    LOG_WARN("events_api_query");
+    return err;
+  }
+
+  if (events_streaming) {
+    LOG_WARN("event stream already active");
+    return HTTP_SERVICE_UNAVAILABLE;
+  }
+
+  if ((err = http_response_start(response, HTTP_OK, NULL))) {
+    LOG_WARN("http_response_start");
+    return err;
+  }
+
+  if ((err = http_response_header(response, "Content-Type", "text/event-stream"))) {
+    LOG_WARN("http_response_header");
+    return err;
+  }
+
+  if ((err = http_response_header(response, "Cache-Control", "no-cache"))) {
+    LOG_WARN("http_response_header");
+    return err;
+  }
+
+  if ((err = http_response_open(response, &file))) {
+    LOG_WARN("http_response_open");
+    return err;
+  }
+
+  LOG_INFO("start event stream interval=%ums", query.interval);
+
+  events_streaming = true;
+
+  // initial event contains all metrics, followed by changes only
+  for (bool force = true; ; force = false) {
+    if ((err = events_send_metrics(file, force))) {
+      break;
+    }
+
+    // allow other requests to be served while sending and waiting
+    http_server_unlock();
+
+    if (fflush(file)) {
+      LOG_DEBUG("fflush: %s", strerror(errno));
+      err = -1;
+    } else {
+      vTaskDelay(query.interval / portTICK_PERIOD_MS);
+    }
+
+    http_server_lock();
+
+    if (err) {
+      break;
+    }
+  }
+
+  events_streaming = false;
+
+  LOG_INFO("end event stream");
+
+  if (fclose(file) < 0) {
+    LOG_DEBUG("fclose: %s", strerror(errno));
+  }
+
+  return 0;
+}
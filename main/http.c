@@ -11,6 +11,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/queue.h>
+#include <freertos/semphr.h>
 
 #include <string.h>
 
@@ -21,13 +22,16 @@
 
 #define HTTP_STREAM_SIZE 1024 // 1+1kB per connection
 
-// maximum number of supported HTTP connections at a time
-#define HTTP_CONNECTION_COUNT 2
+// maximum number of supported HTTP connections at a time, including one long-lived event stream
+#define HTTP_CONNECTION_COUNT 3
 
 // number of accepted connections to queue up for serving
 #define HTTP_CONNECTION_QUEUE_SIZE 2
 #define HTTP_CONNECTION_QUEUE_TIMEOUT 1000 // 1s
 
+// number of server tasks, requests are serialized using http_server_lock() except for long-lived handlers
+#define HTTP_SERVER_TASK_COUNT 2
+
 #define HTTP_AUTHENTICATION_REALM "HTTP username/password"
 #define HTTP_AUTHORIZATION_HEADER_MAX 64
 
@@ -70,9 +74,10 @@ static struct http_state {
   struct http_listener *listener;
   struct http_router *router;
 
-  xTaskHandle listen_task, server_task;
+  xTaskHandle listen_task, server_tasks[HTTP_SERVER_TASK_COUNT];
   xQueueHandle accept_queue; // struct http_connection* for accept()
   xQueueHandle serve_queue; // struct http_connection* for serve()
+  SemaphoreHandle_t serve_mutex; // held by server task while serving request
 } http_state;
 
 int config_http(struct http_state *http, struct http_config *config)
@@ -99,6 +104,11 @@ int config_http(struct http_state *http, struct http_config *config)
     }
   }
 
+  if (!(http->serve_mutex = xSemaphoreCreateMutex())) {
+    LOG_ERROR("xSemaphoreCreateMutex");
+    return -1;
+  }
+
   // connection queues
   if ((http->accept_queue = xQueueCreate(HTTP_CONNECTION_COUNT, sizeof(struct http_connection *))) == NULL) {
     LOG_ERROR("xQueueCreate");
@@ -156,6 +166,11 @@ int init_http()
     return err;
   }
 
+  if ((err = init_system_http())) {
+    LOG_ERROR("init_system_http");
+    return err;
+  }
+
   return 0;
 }
 
@@ -277,6 +292,34 @@ static int http_server_response_headers(struct http_response *response, void *ct
   return 0;
 }
 
+void http_server_lock()
+{
+  if (!xSemaphoreTake(http_state.serve_mutex, portMAX_DELAY)) {
+    LOG_FATAL("xSemaphoreTake");
+  }
+}
+
+void http_server_unlock()
+{
+  if (!xSemaphoreGive(http_state.serve_mutex)) {
+    LOG_FATAL("xSemaphoreGive");
+  }
+}
+
+/* Serialize handlers across server tasks, without holding the lock while reading requests or waiting on keep-alive */
+static int http_server_handler(struct http_request *request, struct http_response *response, void *ctx)
+{
+  int ret;
+
+  http_server_lock();
+
+  ret = http_router_handler(request, response, ctx);
+
+  http_server_unlock();
+
+  return ret;
+}
+
 void http_server_main(void *arg)
 {
   struct http_state *http = arg;
@@ -321,7 +364,7 @@ void http_server_main(void *arg)
       .authenticated = false,
     };
 
-    if ((err = http_connection_serve(connection, &hooks, &http_router_handler, router)) < 0) {
+    if ((err = http_connection_serve(connection, &hooks, &http_server_handler, router)) < 0) {
       LOG_ERROR("http_connection_serve");
     } else if (err > 0) {
       // HTTP connection-close
@@ -397,19 +440,21 @@ int start_http_tasks(struct http_state *http)
     return -1;
   }
 
-  struct task_options http_server_options = {
-    .main       = http_server_main,
-    .name       = HTTP_SERVER_TASK_NAME,
-    .stack_size = HTTP_SERVER_TASK_STACK,
-    .arg        = http,
-    .priority   = HTTP_SERVER_TASK_PRIORITY,
-    .handle     = &http->server_task,
-    .affinity   = HTTP_SERVER_TASK_AFFINITY,
-  };
+  for (unsigned i = 0; i < HTTP_SERVER_TASK_COUNT; i++) {
+    struct task_options http_server_options = {
+      .main       = http_server_main,
+      .name_fmt   = HTTP_SERVER_TASK_NAME_FMT,
+      .stack_size = HTTP_SERVER_TASK_STACK,
+      .arg        = http,
+      .priority   = HTTP_SERVER_TASK_PRIORITY,
+      .handle     = &http->server_tasks[i],
+      .affinity   = HTTP_SERVER_TASK_AFFINITY,
+    };
 
-  if (start_task(http_server_options)) {
-    LOG_ERROR("start_task http-server");
-    return -1;
+    if (start_taskf(http_server_options, i)) {
+      LOG_ERROR("start_task http-server%u", i);
+      return -1;
+    }
   }
 
   return 0;
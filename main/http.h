@@ -6,4 +6,13 @@ extern const struct configtab http_configtab[];
 
 int init_http();
 int init_http_dist();
+int init_system_http();
 int start_http();
+
+/*
+ * Request handlers are called with the server lock held, serializing HTTP handlers across server tasks.
+ *
+ * Long-lived handlers may use http_server_unlock() to allow other requests to be served, and must use http_server_lock() before returning.
+ */
+void http_server_lock();
+void http_server_unlock();
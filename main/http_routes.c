@@ -22,6 +22,7 @@ const struct http_route http_routes[] = {
   /* system_http.c */
   { "GET",  "api/system",         system_api_handler,         NULL },
   { "GET",  "api/system/tasks",   system_api_tasks_handler,   NULL },
+  { "GET",  "api/system/history", system_api_history_handler, NULL },
   { "POST", "api/system/restart", system_api_restart_handler, NULL },
 
   /* wifi_http.c */
@@ -47,5 +48,8 @@ const struct http_route http_routes[] = {
   { "GET",  "api/status",         user_api_get_status,    NULL },
   { "POST", "api/button",         user_api_post_button,   NULL },
 
+  /* events_http.c */
+  { "GET",  "api/events",         events_api_handler,     NULL },
+
   {}
 };
@@ -26,6 +26,7 @@ int config_api_post(struct http_request *request, struct http_response *response
 /* system_http.c */
 int system_api_handler(struct http_request *request, struct http_response *response, void *ctx);
 int system_api_tasks_handler(struct http_request *request, struct http_response *response, void *ctx);
+int system_api_history_handler(struct http_request *request, struct http_response *response, void *ctx);
 int system_api_restart_handler(struct http_request *request, struct http_response *response, void *ctx);
 
 /* wifi_http.c */
@@ -52,3 +53,6 @@ int leds_api_static_post(struct http_request *request, struct http_response *res
 /* user_http.c */
 int user_api_get_status(struct http_request *request, struct http_response *response, void *ctx);
 int user_api_post_button(struct http_request *request, struct http_response *response, void *ctx);
+
+/* events_http.c */
+int events_api_handler(struct http_request *request, struct http_response *response, void *ctx);
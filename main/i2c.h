@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmd.h>
 #include <config.h>
 
 #include <sdkconfig.h>
@@ -18,4 +19,6 @@
   int start_i2c_gpio();
 
   extern const struct configtab *i2c_gpio_configtabs[I2C_GPIO_COUNT];
+
+  extern const struct cmdtab i2c_gpio_cmdtab;
 #endif
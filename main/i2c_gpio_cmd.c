@@ -0,0 +1,54 @@
+#include "i2c.h"
+#include "i2c_gpio.h"
+
+#include <gpio_i2c_stats.h>
+#include <logging.h>
+#include <stats_print.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_I2C_GPIO_ENABLED
+  int i2c_gpio_cmd_stats(int argc, char **argv, void *ctx)
+  {
+    bool reset = false;
+
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+      reset = true;
+    }
+
+    for (unsigned i = 0; i < I2C_GPIO_COUNT + 1; i++) {
+      struct gpio_i2c_dev *dev = i2c_gpio_devs[i];
+      struct gpio_i2c_stats stats;
+
+      if (!dev) {
+        continue;
+      }
+
+      gpio_i2c_stats(dev, &stats, reset);
+
+      printf("i2c-gpio%u:\n", i);
+
+      print_stats_timer  ("I2C",    "read",     &stats.read);
+      print_stats_timer  ("I2C",    "write",    &stats.write);
+      print_stats_counter("I2C",    "error",    &stats.error);
+      printf("\t\n");
+      print_stats_counter("Cache",  "read",     &stats.read_cached);
+      print_stats_counter("Cache",  "write",    &stats.write_skip);
+      printf("\t\n");
+      print_stats_counter("INT",    "intr",     &stats.intr);
+      printf("\n");
+    }
+
+    return 0;
+  }
+
+  const struct cmd i2c_gpio_commands[] = {
+    { "stats",  i2c_gpio_cmd_stats, .usage = "[reset]", .describe = "Show I2C transaction and cache stats" },
+    { }
+  };
+
+  const struct cmdtab i2c_gpio_cmdtab = {
+    .commands = i2c_gpio_commands,
+  };
+#endif
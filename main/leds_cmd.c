@@ -13,6 +13,7 @@
 #include <leds_stats.h>
 #include <leds_status.h>
 #include <stats_print.h>
+#include <system_heap.h>
 
 #include <string.h>
 
@@ -418,12 +419,19 @@ int leds_cmd_stats(int argc, char **argv, void *ctx)
   #if CONFIG_LEDS_SPI_ENABLED
     print_stats_timer("spi", "open",   &stats.spi.open);
     print_stats_timer("spi", "tx",     &stats.spi.tx);
+    print_stats_gauge("spi", "encode", &stats.spi.encode);
+  #if CONFIG_LEDS_SPI_INTR_WRITE_ENABLED
+    print_stats_gauge("spi", "throughput", &stats.spi.throughput);
+    print_stats_gauge("spi", "clock", &stats.spi.clock);
+  #endif
     printf("\n");
   #endif
 
   #if CONFIG_LEDS_UART_ENABLED
     print_stats_timer("uart", "open",   &stats.uart.open);
     print_stats_timer("uart", "tx",     &stats.uart.tx);
+    print_stats_gauge("uart", "encode", &stats.uart.encode);
+    print_stats_gauge("uart", "pixels/s", &stats.uart.pixel_rate);
     printf("\n");
   #endif
 
@@ -435,6 +443,7 @@ int leds_cmd_stats(int argc, char **argv, void *ctx)
     print_stats_timer("i2s0", "write",   &stats.i2s0.write);
     print_stats_timer("i2s0", "start",   &stats.i2s0.start);
     print_stats_timer("i2s0", "flush",   &stats.i2s0.flush);
+    print_stats_gauge("i2s0", "encode",  &stats.i2s0.encode);
     printf("\n");
   #endif
   #if LEDS_I2S_INTERFACE_COUNT > 1
@@ -445,6 +454,7 @@ int leds_cmd_stats(int argc, char **argv, void *ctx)
     print_stats_timer("i2s1", "write",   &stats.i2s1.write);
     print_stats_timer("i2s1", "start",   &stats.i2s1.start);
     print_stats_timer("i2s1", "flush",   &stats.i2s1.flush);
+    print_stats_gauge("i2s1", "encode",  &stats.i2s1.encode);
     printf("\n");
   #endif
   }
@@ -455,6 +465,9 @@ int leds_cmd_stats(int argc, char **argv, void *ctx)
 
     print_stats_timer("sequence", "read", &stats->read);
     print_stats_counter("sequence", "skip", &stats->skip);
+    print_stats_gauge("sequence", "read bytes/s", &stats->read_rate);
+    print_stats_gauge("sequence", "buffer", &stats->buffer);
+    print_stats_counter("sequence", "underrun", &stats->underrun);
   }
 
   for (unsigned i = 0; i < LEDS_COUNT; i++) {
@@ -497,6 +510,181 @@ int leds_cmd_stats(int argc, char **argv, void *ctx)
   return 0;
 }
 
+#define LEDS_BENCH_ROUNDS 1000
+
+static void print_leds_bench(const char *desc, const struct stats_timer *timer, unsigned count)
+{
+  float seconds = stats_timer_total_seconds(timer);
+
+  printf("\t%-24s: %8u rounds %8.3fms/round %10.1f pixels/s\n", desc,
+    timer->count,
+    stats_timer_average_seconds(timer) * 1000.0f,
+    seconds > 0.0f ? (float) count * (float) timer->count / seconds : 0.0f
+  );
+}
+
+static int leds_cmd_bench_placement(const struct leds_options *options, enum system_heap_placement placement, const char *desc, unsigned rounds)
+{
+  struct leds_bench_stats stats;
+  int err;
+
+  if ((err = leds_bench(options, placement, rounds, &stats))) {
+    LOG_ERROR("leds_bench");
+    return err;
+  }
+
+  printf("%s RAM:\n", desc);
+
+  print_leds_bench("set all",       &stats.set_all,       options->count);
+  print_leds_bench("count active",  &stats.count_active,  options->count);
+  print_leds_bench("count power",   &stats.count_power,   options->count);
+  print_leds_bench("format rgb",    &stats.format_rgb,    options->count);
+  print_leds_bench("format grb",    &stats.format_grb,    options->count);
+  print_leds_bench("format rgbw",   &stats.format_rgbw,   options->count);
+
+  // reference kernels
+  print_leds_bench("set all (bytes)",       &stats.set_all_bytes,       options->count);
+  print_leds_bench("count active (bytes)",  &stats.count_active_bytes,  options->count);
+  print_leds_bench("count power (bytes)",   &stats.count_power_bytes,   options->count);
+  print_leds_bench("set all (planar)",      &stats.set_all_planar,      options->count);
+  print_leds_bench("count active (planar)", &stats.count_active_planar, options->count);
+  print_leds_bench("count power (planar)",  &stats.count_power_planar,  options->count);
+
+  return 0;
+}
+
+int leds_cmd_bench(int argc, char **argv, void *ctx)
+{
+  const struct leds_config *config;
+  struct leds_state *state;
+  unsigned leds_id, rounds = LEDS_BENCH_ROUNDS;
+  int err;
+
+  if ((err = cmd_arg_uint(argc, argv, 1, &leds_id)))
+    return err;
+  if ((argc > 2) && (err = cmd_arg_uint(argc, argv, 2, &rounds)))
+    return err;
+
+  if ((err = lookup_leds(leds_id, &config, &state))) {
+    return err;
+  }
+
+  const struct leds_options *options = leds_options(state->leds);
+
+  printf("leds%u: %s x %u\n", leds_id, config_enum_to_string(leds_protocol_enum, options->protocol), options->count);
+
+  if ((err = leds_cmd_bench_placement(options, SYSTEM_HEAP_INTERNAL, "Internal", rounds))) {
+    return err;
+  }
+
+  // compare the read/write penalty for pixel state in external RAM
+  if (system_heap_external() && (err = leds_cmd_bench_placement(options, SYSTEM_HEAP_EXTERNAL, "External", rounds))) {
+    return err;
+  }
+
+  return 0;
+}
+
+#define LEDS_ALLOC_FRAMES 100
+#define LEDS_ALLOC_FRAME_TIMEOUT (1000 / portTICK_RATE_MS)
+
+/* Output one frame from the leds task, waiting for it to complete */
+static int leds_cmd_alloc_frame(struct leds_state *state, unsigned frame)
+{
+  const volatile uint32_t *output_count = &leds_stats[state->index].output.count;
+  uint32_t count = *output_count;
+  TickType_t tick = xTaskGetTickCount();
+  int err;
+
+  if ((err = start_leds_update(state, LEDS_UPDATE_CMD))) {
+    LOG_ERROR("start_leds_update");
+    return err;
+  }
+
+  // vary the pixels, so that every frame is output
+  leds_set_all(state->leds, (struct leds_color) { .r = frame, .g = frame, .b = frame });
+
+  end_leds_update(state);
+
+  while (*output_count == count) {
+    if (xTaskGetTickCount() - tick > LEDS_ALLOC_FRAME_TIMEOUT) {
+      LOG_ERROR("leds%d: output timeout", state->index + 1);
+      return -1;
+    }
+
+    vTaskDelay(1);
+  }
+
+  return 0;
+}
+
+static void leds_cmd_alloc_snapshot(struct system_heap_caps_info infos[SYSTEM_HEAP_CAPS_MAX], bool present[SYSTEM_HEAP_CAPS_MAX])
+{
+  for (enum system_heap_caps caps = 0; caps < SYSTEM_HEAP_CAPS_MAX; caps++) {
+    present[caps] = !system_heap_caps_info_get(caps, &infos[caps]);
+  }
+}
+
+int leds_cmd_alloc(int argc, char **argv, void *ctx)
+{
+  struct system_heap_caps_info start[SYSTEM_HEAP_CAPS_MAX], end[SYSTEM_HEAP_CAPS_MAX];
+  bool start_present[SYSTEM_HEAP_CAPS_MAX], end_present[SYSTEM_HEAP_CAPS_MAX];
+  const struct leds_config *config;
+  struct leds_state *state;
+  unsigned leds_id, frames = LEDS_ALLOC_FRAMES;
+  bool alloc = false;
+  int err;
+
+  if ((err = cmd_arg_uint(argc, argv, 1, &leds_id)))
+    return err;
+  if ((argc > 2) && (err = cmd_arg_uint(argc, argv, 2, &frames)))
+    return err;
+
+  if ((err = lookup_leds(leds_id, &config, &state))) {
+    return err;
+  }
+
+  // any lazy allocations on the first frame are not part of the per-frame path
+  if ((err = leds_cmd_alloc_frame(state, 0))) {
+    return err;
+  }
+
+  leds_cmd_alloc_snapshot(start, start_present);
+
+  for (unsigned frame = 1; frame <= frames; frame++) {
+    if ((err = leds_cmd_alloc_frame(state, frame))) {
+      return err;
+    }
+  }
+
+  leds_cmd_alloc_snapshot(end, end_present);
+
+  printf("leds%u: %u frames\n", leds_id, frames);
+
+  for (enum system_heap_caps caps = 0; caps < SYSTEM_HEAP_CAPS_MAX; caps++) {
+    if (!start_present[caps] || !end_present[caps]) {
+      continue;
+    }
+
+    int free_diff = (int) end[caps].free_size - (int) start[caps].free_size;
+    int blocks_diff = (int) end[caps].allocated_blocks - (int) start[caps].allocated_blocks;
+
+    printf("\t%-10s: free %+6d bytes, allocated %+4d blocks\n", system_heap_caps_str(caps), free_diff, blocks_diff);
+
+    if (free_diff || blocks_diff) {
+      alloc = true;
+    }
+  }
+
+  if (alloc) {
+    // also includes any concurrent allocations from other tasks, e.g. network traffic
+    LOG_ERROR("leds%u: heap changed across %u frames", leds_id, frames);
+    return -1;
+  }
+
+  return 0;
+}
+
 const struct cmd leds_commands[] = {
   { "info",     leds_cmd_info,                                          .describe = "Show LED info" },
   { "status",   leds_cmd_status,                                        .describe = "Show LED status" },
@@ -507,6 +695,8 @@ const struct cmd leds_commands[] = {
   { "update",   leds_cmd_update,  .usage = "[LEDS-ID]",                 .describe = "Refresh one or all LED outputs" },
   { "test",     leds_cmd_test,    .usage = "[MODE]",                    .describe = "Output test patterns" },
   { "stats",    leds_cmd_stats,   .usage = "[reset]",                   .describe = "Show/reset LED stats" },
+  { "bench",    leds_cmd_bench,   .usage = "LEDS-ID [ROUNDS]",          .describe = "Benchmark LED pixel processing" },
+  { "alloc",    leds_cmd_alloc,   .usage = "LEDS-ID [FRAMES]",          .describe = "Output frames and check for heap allocations" },
   { }
 };
 
@@ -10,6 +10,8 @@
 
 #define LEDS_LIMIT_GROUPS_MAX 64
 #define LEDS_SEQUENCE_FILE_MAX 64
+#define LEDS_SEQUENCE_READ_AHEAD_DEFAULT 4
+#define LEDS_SEQUENCE_READ_AHEAD_MAX 32
 
 struct leds_state *state;
 
@@ -104,6 +106,7 @@ struct leds_sequence_config {
   bool enabled;
   bool loop;
   char file[LEDS_SEQUENCE_FILE_MAX];
+  uint16_t read_ahead;
 };
 
 struct leds_config {
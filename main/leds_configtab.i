@@ -237,7 +237,7 @@ const struct configtab LEDS_CONFIGTAB[] = {
     .enum_type = { .value = &LEDS_CONFIG.sequence_format, .values = leds_format_enum },
   },
   { CONFIG_TYPE_UINT16, "sequence_channel_start",
-    .description = "Output LED data starting from specific channel. Default 0 -> all channels",
+    .description = "Output LED data starting from specific channel of the frame data, counted within the sparse ranges for sparse files. Default 0 -> all channels",
     .uint16_type = { .value = &LEDS_CONFIG.sequence_channel_start },
   },
   { CONFIG_TYPE_UINT16, "sequence_channel_count",
@@ -37,16 +37,28 @@ const struct configtab leds_sequence_configtab[] = {
     .file_type = { .value = leds_sequence_config.file, .size = sizeof(leds_sequence_config.file), .paths = leds_sequence_paths },
     .description = "Read LEDs sequence file from SD-Card",
   },
+  { CONFIG_TYPE_UINT16, "read_ahead",
+    .uint16_type = { .value = &leds_sequence_config.read_ahead, .default_value = LEDS_SEQUENCE_READ_AHEAD_DEFAULT, .max = LEDS_SEQUENCE_READ_AHEAD_MAX },
+    .description = "Number of frames to read ahead from the sequence file, to absorb SD-Card latency spikes.",
+  },
   {},
 };
 
+#define LEDS_SEQUENCE_FILE_BUFFER_SIZE 4096 // multiple of SD-Card sector size
+
 // state
 struct leds_sequence {
-  xTaskHandle task;
+  xTaskHandle task, read_task;
 
   struct fseq *fseq;
-  struct fseq_frame *fseq_frame;
   enum fseq_mode fseq_mode;
+
+  // read-ahead ring of frames
+  unsigned read_ahead;
+  struct fseq_frame **fseq_frames;
+
+  xQueueHandle free_queue; // struct fseq_frame *
+  xQueueHandle read_queue; // struct fseq_frame *, NULL on stop
 } *leds_sequence;
 
 int init_leds_sequence()
@@ -70,15 +82,18 @@ int init_leds_sequence()
     return -1;
   }
 
+  // fewer, larger reads from the SD-Card
+  if (setvbuf(file, NULL, _IOFBF, LEDS_SEQUENCE_FILE_BUFFER_SIZE)) {
+    LOG_WARN("setvbuf %u: %s", LEDS_SEQUENCE_FILE_BUFFER_SIZE, strerror(errno));
+  }
+
   if ((err = fseq_new(&leds_sequence->fseq, file))) {
     LOG_ERROR("fseq_new");
     return err;
   }
 
-  if ((err = fseq_frame_new(&leds_sequence->fseq_frame, leds_sequence->fseq))) {
-    LOG_ERROR("fseq_frame_new");
-    return err;
-  }
+  // at least one frame buffer for playback
+  leds_sequence->read_ahead = config->read_ahead ? config->read_ahead : 1;
 
   // stay in sync instead of slowing down playback
   leds_sequence->fseq_mode |= FSEQ_MODE_SKIP;
@@ -104,52 +119,121 @@ int config_leds_sequence(struct leds_state *state, const struct leds_config *con
     return -1;
   }
 
-  if (!(state->sequence->queue = xQueueCreate(1, fseq_frame_size(leds_sequence->fseq_frame)))) {
-    LOG_ERROR("xQueueCreate: 1x%u", fseq_frame_size(leds_sequence->fseq_frame));
+  // only read the channels used by this output
+  unsigned channel = config->sequence_channel_start ? config->sequence_channel_start - 1 : 0;
+  unsigned count = config->sequence_channel_count;
+
+  if ((err = fseq_window(leds_sequence->fseq, channel, count, &state->sequence->fseq_window)) < 0) {
+    LOG_ERROR("fseq_window");
+    return err;
+  } else if (err) {
+    LOG_WARN("sequence_channel_start=%u sequence_channel_count=%u not present in sequence file, sequence disabled", config->sequence_channel_start, config->sequence_channel_count);
+
+    free(state->sequence);
+    state->sequence = NULL;
+
+    return 0;
+  }
+
+  if (!(state->sequence->queue = xQueueCreate(1, state->sequence->fseq_window.size))) {
+    LOG_ERROR("xQueueCreate: 1x%u", state->sequence->fseq_window.size);
     return -1;
   }
 
-  if ((err = fseq_frame_new(&state->sequence->fseq_frame, leds_sequence->fseq))) {
-    LOG_ERROR("fseq_frame_new");
+  if ((err = fseq_frame_new_window(&state->sequence->fseq_frame, &state->sequence->fseq_window))) {
+    LOG_ERROR("fseq_frame_new_window");
     return -1;
   }
 
   return 0;
 }
 
-static void leds_sequence_main(void *ctx)
+static void leds_sequence_read_main(void *ctx)
 {
   struct leds_sequence *leds_sequence = ctx;
   struct leds_sequence_stats *stats = &leds_sequence_stats;
+  struct fseq_frame *frame;
   int err;
 
-  if ((err = fseq_start(leds_sequence->fseq, leds_sequence->fseq_mode))) {
-    LOG_ERROR("fseq_start");
-    goto error;
+  for (;;) {
+    // wait for playback to release a frame buffer
+    if (!xQueueReceive(leds_sequence->free_queue, &frame, portMAX_DELAY)) {
+      continue;
+    }
+
+    // read next frame into buffer, any skipped frames are already late
+    uint64_t start = esp_timer_get_time();
+
+    WITH_STATS_TIMER(&stats->read) {
+      err = fseq_read(leds_sequence->fseq, frame);
+    }
+
+    uint64_t time = esp_timer_get_time() - start;
+
+    if (err < 0) {
+      user_alert(USER_ALERT_ERROR_LEDS_SEQUENCE_READ);
+      LOG_ERROR("fseq_read");
+      goto error;
+    } else if (err) {
+      LOG_WARN("fseq_read: skip %d frames", err);
+
+      stats_counter_add(&stats->skip, err);
+    }
+
+    if (time) {
+      stats_gauge_sample(&stats->read_rate, (uint64_t) frame->size * 1000000 / time);
+    }
+
+    xQueueSend(leds_sequence->read_queue, &frame, portMAX_DELAY);
+
+    if (!fseq_tick(leds_sequence->fseq)) {
+      LOG_INFO("stop");
+      goto stop;
+    }
   }
 
+error:
+  user_alert(USER_ALERT_ERROR_LEDS_SEQUENCE);
+  LOG_ERROR("task=%p stopped", leds_sequence->read_task);
+
+stop:
+  // end of sequence, stops playback
+  frame = NULL;
+
+  xQueueSend(leds_sequence->read_queue, &frame, portMAX_DELAY);
+
+  leds_sequence->read_task = NULL;
+  vTaskDelete(NULL);
+}
+
+static void leds_sequence_main(void *ctx)
+{
+  struct leds_sequence *leds_sequence = ctx;
+  struct leds_sequence_stats *stats = &leds_sequence_stats;
+  struct fseq_frame *frame;
+
   for (;;) {
-    // pre-read next into frame buffer
-    WITH_STATS_TIMER(&stats->read) {
-      if ((err = fseq_read(leds_sequence->fseq, leds_sequence->fseq_frame)) < 0) {
-        user_alert(USER_ALERT_ERROR_LEDS_SEQUENCE_READ);
-        LOG_ERROR("fseq_read");
-        continue; // any way to recovery, or will this just be a busy-loop?
-      } else if (err) {
-        LOG_WARN("fseq_read: skip %d frames", err);
-
-        stats_counter_add(&stats->skip, err);
+    stats_gauge_sample(&stats->buffer, uxQueueMessagesWaiting(leds_sequence->read_queue));
+
+    // get next pre-read frame
+    if (!xQueueReceive(leds_sequence->read_queue, &frame, 0)) {
+      stats_counter_increment(&stats->underrun);
+
+      if (!xQueueReceive(leds_sequence->read_queue, &frame, portMAX_DELAY)) {
+        continue;
       }
     }
 
+    if (!frame) {
+      LOG_INFO("stop");
+      break;
+    }
+
     // wait for frame tick
-    TickType_t tick = fseq_tick(leds_sequence->fseq);
+    TickType_t tick = frame->tick;
     TickType_t t = xTaskGetTickCount();
 
-    if (!tick) {
-      LOG_INFO("stop");
-      goto stop;
-    } else if (tick > t) {
+    if (tick > t) {
       vTaskDelay(tick - t);
     }
 
@@ -162,23 +246,77 @@ static void leds_sequence_main(void *ctx)
         continue;
       }
 
-      xQueueOverwrite(state->sequence->queue, leds_sequence->fseq_frame);
+      // only copy the channels used by this output
+      xQueueOverwrite(state->sequence->queue, fseq_frame_window(frame, &state->sequence->fseq_window));
       notify_leds_task(state, 1 << LEDS_EVENT_SEQUENCE_BIT);
     }
-  }
 
-error:
-  user_alert(USER_ALERT_ERROR_LEDS_SEQUENCE);
-  LOG_ERROR("task=%p stopped", leds_sequence->task);
+    // release frame buffer for read-ahead
+    xQueueSend(leds_sequence->free_queue, &frame, portMAX_DELAY);
+  }
 
-stop:
   leds_sequence->task = NULL;
   vTaskDelete(NULL);
 }
 
+static int init_leds_sequence_frames(struct leds_sequence *leds_sequence)
+{
+  int err;
+
+  if (!(leds_sequence->fseq_frames = calloc(leds_sequence->read_ahead, sizeof(*leds_sequence->fseq_frames)))) {
+    LOG_ERROR("calloc");
+    return -1;
+  }
+
+  if (!(leds_sequence->free_queue = xQueueCreate(leds_sequence->read_ahead, sizeof(struct fseq_frame *)))) {
+    LOG_ERROR("xQueueCreate");
+    return -1;
+  }
+
+  // one extra for the stop marker
+  if (!(leds_sequence->read_queue = xQueueCreate(leds_sequence->read_ahead + 1, sizeof(struct fseq_frame *)))) {
+    LOG_ERROR("xQueueCreate");
+    return -1;
+  }
+
+  // sized to cover each fseq_window()
+  for (unsigned i = 0; i < leds_sequence->read_ahead; i++) {
+    if ((err = fseq_frame_new(&leds_sequence->fseq_frames[i], leds_sequence->fseq))) {
+      LOG_ERROR("fseq_frame_new");
+      goto error;
+    }
+
+    xQueueSend(leds_sequence->free_queue, &leds_sequence->fseq_frames[i], 0);
+  }
+
+  LOG_INFO("read_ahead=%u frames x %u bytes", leds_sequence->read_ahead, leds_sequence->fseq_frames[0]->size);
+
+  return 0;
+
+error:
+  xQueueReset(leds_sequence->free_queue);
+
+  for (unsigned i = 0; i < leds_sequence->read_ahead; i++) {
+    fseq_frame_free(leds_sequence->fseq_frames[i]);
+
+    leds_sequence->fseq_frames[i] = NULL;
+  }
+
+  return err;
+}
+
 int start_leds_sequence()
 {
   const struct leds_sequence_config *config = &leds_sequence_config;
+  struct task_options read_task_options = {
+    .main       = leds_sequence_read_main,
+    .name       = LEDS_SEQUENCE_READ_TASK_NAME,
+    .stack_size = LEDS_SEQUENCE_READ_TASK_STACK,
+    .arg        = leds_sequence,
+    .priority   = LEDS_SEQUENCE_READ_TASK_PRIORITY,
+    .handle     = &leds_sequence->read_task,
+    .affinity   = LEDS_SEQUENCE_READ_TASK_AFFINITY,
+  };
   struct task_options task_options = {
     .main       = leds_sequence_main,
     .name       = LEDS_SEQUENCE_TASK_NAME,
@@ -205,6 +343,24 @@ int start_leds_sequence()
     return -1;
   }
 
+  if ((err = init_leds_sequence_frames(leds_sequence))) {
+    LOG_ERROR("init_leds_sequence_frames");
+    return err;
+  }
+
+  if ((err = fseq_start(leds_sequence->fseq, leds_sequence->fseq_mode))) {
+    LOG_ERROR("fseq_start");
+    user_alert(USER_ALERT_ERROR_LEDS_SEQUENCE);
+    return err;
+  }
+
+  if ((err = start_task(read_task_options))) {
+    LOG_ERROR("start_task");
+    return err;
+  } else {
+    LOG_INFO("start read task=%p", leds_sequence->read_task);
+  }
+
   if ((err = start_task(task_options))) {
     LOG_ERROR("start_task");
     return err;
@@ -224,31 +380,10 @@ static int set_leds_sequence(struct leds_state *state, const struct fseq_frame *
     .group = config->sequence_leds_group,
     .offset = config->sequence_leds_offset,
   };
-  const uint8_t *ptr = frame->buf;
-  size_t len = frame->size;
   int err;
 
-  if (config->sequence_channel_start) {
-    unsigned offset = config->sequence_channel_start - 1;
-
-    if (offset > len) {
-      ptr = NULL;
-      len = 0;
-    } else {
-      ptr += offset;
-      len -= offset;
-    }
-  }
-
-  if (config->sequence_channel_count) {
-    if (config->sequence_channel_count > len) {
-
-    } else {
-      len = config->sequence_channel_count;
-    }
-  }
-
-  if ((err = leds_set_format(state->leds, config->sequence_format, ptr, len, params))) {
+  // frame only contains the sequence_channel_start/count window
+  if ((err = leds_set_format(state->leds, config->sequence_format, frame->buf, frame->size, params))) {
     LOG_WARN("leds_set_format");
     return err;
   }
@@ -278,7 +413,7 @@ int leds_sequence_update(struct leds_state *state, EventBits_t event_bits)
 {
   int err;
 
-  if (!xQueueReceive(state->sequence->queue, state->sequence->fseq_frame, 0)) {
+  if (!xQueueReceive(state->sequence->queue, state->sequence->fseq_frame->buf, 0)) {
     LOG_WARN("xQueueReceive: queue empty");
     return 0;
   }
@@ -9,10 +9,12 @@
 #include <fseq.h>
 
 struct leds_sequence_state {
-  // XXX: wasteful to have 1+N*2 copies of each fseq_frame
-  xQueueHandle queue; // struct fseq_frame
+  // channels within each fseq frame
+  struct fseq_window fseq_window;
 
-  struct fseq_frame *fseq_frame;
+  xQueueHandle queue; // fseq_window.size bytes
+
+  struct fseq_frame *fseq_frame; // fseq_window copy
 };
 
 int init_leds_sequence();
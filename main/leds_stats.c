@@ -8,6 +8,9 @@ void init_leds_sequence_stats(struct leds_sequence_stats *stats)
 {
   stats_timer_init(&stats->read);
   stats_counter_init(&stats->skip);
+  stats_gauge_init(&stats->read_rate);
+  stats_gauge_init(&stats->buffer);
+  stats_counter_init(&stats->underrun);
 }
 
 void init_leds_stats()
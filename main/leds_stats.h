@@ -8,6 +8,15 @@
 struct leds_sequence_stats {
   struct stats_timer read;
   struct stats_counter skip;
+
+  // read rate per frame, in bytes/s
+  struct stats_gauge read_rate;
+
+  // read-ahead frames buffered at playback
+  struct stats_gauge buffer;
+
+  // playback waited for read
+  struct stats_counter underrun;
 };
 
 struct leds_stats {
@@ -50,23 +50,31 @@ static void update_stats_timer_metrics(struct stats_timer *baseline, const struc
   *baseline = *timer;
 }
 
-void update_leds_status(struct leds_state *state)
+static void update_leds_status(struct leds_status_timers *baseline, struct leds_status_timer_metrics *metrics, const struct leds_status_timers *timers)
 {
-  struct stats_timer task_timer = get_leds_task_timer(state);
-  struct stats_timer interface_timer = get_leds_interface_timer(state);
-
-  update_stats_timer_metrics(&state->status_timers.task, &task_timer, &state->status_timer_metrics.task);
-  update_stats_timer_metrics(&state->status_timers.interface, &interface_timer, &state->status_timer_metrics.interface);
+  update_stats_timer_metrics(&baseline->task, &timers->task, &metrics->task);
+  update_stats_timer_metrics(&baseline->interface, &timers->interface, &metrics->interface);
 }
 
-void get_leds_status(struct leds_state *state, struct leds_status *status)
+/* Written by the leds task, copied by get_leds_status() */
+struct leds_status_snapshot {
+  // odd while the leds task is writing
+  volatile unsigned seq;
+
+  struct leds_status status;
+  struct leds_status_timers timers;
+};
+
+static struct leds_status_snapshot leds_status_snapshots[LEDS_COUNT];
+
+void publish_leds_status(struct leds_state *state)
 {
-  *status = (struct leds_status) {};
+  struct leds_status_snapshot *snapshot = &leds_status_snapshots[state->index];
+  struct leds_status *status = &snapshot->status;
 
-  // TODO: timer interval?
-  update_leds_status(state);
+  snapshot->seq++;
+  __sync_synchronize();
 
-  status->tick = xTaskGetTickCount();
   status->update_tick = state->update_tick;
   status->update_state = state->update_state;
   status->active = leds_is_active(state->leds);
@@ -85,6 +93,49 @@ void get_leds_status(struct leds_state *state, struct leds_status *status)
   leds_get_limit_total_status(state->leds, &status->limit_total_status);
   leds_get_limit_groups_status(state->leds, status->limit_groups_status, &status->limit_groups_count);
 
+  // timers
+  snapshot->timers.task = get_leds_task_timer(state);
+  snapshot->timers.interface = get_leds_interface_timer(state);
+
+  __sync_synchronize();
+  snapshot->seq++;
+}
+
+void get_leds_status_metrics(struct leds_state *state, struct leds_status *status, struct leds_status_timers *baseline, struct leds_status_timer_metrics *metrics)
+{
+  const struct leds_status_snapshot *snapshot = &leds_status_snapshots[state->index];
+  struct leds_status_timers timers;
+  unsigned seq;
+
+  for (;;) {
+    seq = snapshot->seq;
+    __sync_synchronize();
+
+    if (seq & 1) {
+      // leds task is writing
+      vTaskDelay(1);
+      continue;
+    }
+
+    *status = snapshot->status;
+    timers = snapshot->timers;
+
+    __sync_synchronize();
+
+    if (snapshot->seq == seq) {
+      break;
+    }
+  }
+
+  status->tick = xTaskGetTickCount();
+
   // metrics
-  status->metrics = state->status_timer_metrics;
+  update_leds_status(baseline, metrics, &timers);
+
+  status->metrics = *metrics;
+}
+
+void get_leds_status(struct leds_state *state, struct leds_status *status)
+{
+  get_leds_status_metrics(state, status, &state->status_timers, &state->status_timer_metrics);
 }
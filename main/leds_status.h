@@ -27,4 +27,11 @@ struct leds_status {
 
 extern const struct config_enum leds_update_state_enum[];
 
+/* Publish status snapshot from the leds task, once per output frame */
+void publish_leds_status(struct leds_state *state);
+
+/* Copy last published status snapshot, without touching the live leds state */
 void get_leds_status(struct leds_state *leds, struct leds_status *status);
+
+/* Copy last published status snapshot, with metrics averaged against the caller's own baseline */
+void get_leds_status_metrics(struct leds_state *leds, struct leds_status *status, struct leds_status_timers *baseline, struct leds_status_timer_metrics *metrics);
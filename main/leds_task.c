@@ -3,6 +3,7 @@
 #include "leds_state.h"
 #include "leds_static.h"
 #include "leds_stats.h"
+#include "leds_status.h"
 #include "leds_task.h"
 #include "leds_test.h"
 
@@ -10,6 +11,7 @@
 #include "user.h"
 
 #include <logging.h>
+#include <system.h>
 
 #define LEDS_MUTEX_TIMEOUT (1000 / portTICK_RATE_MS)
 
@@ -156,6 +158,8 @@ static void leds_main(void *ctx)
     goto error;
   }
 
+  publish_leds_status(state);
+
   for(stats_timer_start_t loop_start;; stats_timer_stop(&stats->loop, &loop_start)) {
     EventBits_t event_bits = leds_task_wait(state);
     bool update = false;
@@ -258,8 +262,12 @@ static void leds_main(void *ctx)
           LOG_WARN("leds%d: output_leds", state->index + 1);
           user_alert(USER_ALERT_ERROR_LEDS);
           reset_leds(state);
+        } else {
+          system_boot_frame();
         }
       }
+
+      publish_leds_status(state);
     }
   }
 
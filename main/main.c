@@ -13,6 +13,8 @@
 #include "pin_mutex.h"
 #include "sdcard.h"
 #include "system.h"
+#include "system_history.h"
+#include "tasks.h"
 #include "user.h"
 #include "usb_pd_sink.h"
 #include "user_events.h"
@@ -22,6 +24,83 @@
 #include <logging.h>
 #include <system.h>
 
+static TaskHandle_t boot_task, boot_network_task;
+
+static void boot_network()
+{
+  int err;
+
+  LOG_INFO("network");
+
+  if ((err = init_wifi())) {
+    LOG_ERROR("init_wifi");
+    user_alert(USER_ALERT_ERROR_SETUP);
+  }
+
+#if CONFIG_ETH_ENABLED
+  if ((err = init_eth())) {
+    LOG_ERROR("init_eth");
+    user_alert(USER_ALERT_ERROR_SETUP);
+  }
+#endif
+
+  if ((err = init_http())) {
+    LOG_ERROR("init_http");
+    user_alert(USER_ALERT_ERROR_SETUP);
+  }
+
+  if ((err = start_wifi_boot())) {
+    LOG_ERROR("start_wifi_boot");
+    user_alert(USER_ALERT_ERROR_START);
+  }
+
+#if CONFIG_ETH_ENABLED
+  if ((err = start_eth())) {
+    LOG_ERROR("start_eth");
+    user_alert(USER_ALERT_ERROR_START);
+  }
+#endif
+
+  if ((err = start_http())) {
+    LOG_ERROR("start_http");
+    user_alert(USER_ALERT_ERROR_START);
+  }
+}
+
+static void boot_network_main(void *ctx)
+{
+  boot_network();
+
+  xTaskNotifyGive(boot_task);
+
+  vTaskDelete(NULL);
+}
+
+static int start_boot_network()
+{
+  struct task_options task_options = {
+    .main       = boot_network_main,
+    .name       = BOOT_NETWORK_TASK_NAME,
+    .stack_size = BOOT_NETWORK_TASK_STACK,
+    .priority   = BOOT_NETWORK_TASK_PRIORITY,
+    .handle     = &boot_network_task,
+    .affinity   = BOOT_NETWORK_TASK_AFFINITY,
+  };
+
+  boot_task = xTaskGetCurrentTaskHandle();
+
+  return start_task(task_options);
+}
+
+static void wait_boot_network()
+{
+  if (!boot_network_task) {
+    return;
+  }
+
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
 void app_main(void)
 {
   int err;
@@ -94,6 +173,11 @@ void app_main(void)
     abort();
   }
 
+  if ((err = init_system_history())) {
+    LOG_ERROR("init_system_history");
+    user_alert(USER_ALERT_ERROR_SETUP);
+  }
+
   if ((err = init_console())) {
     LOG_ERROR("init_console");
     user_alert(USER_ALERT_ERROR_BOOT);
@@ -140,6 +224,11 @@ void app_main(void)
     user_alert(USER_ALERT_ERROR_START);
   }
 
+  if ((err = start_system_history()) < 0) {
+    LOG_ERROR("start_system_history");
+    user_alert(USER_ALERT_ERROR_START);
+  }
+
 #if CONFIG_I2C_GPIO_ENABLED
   if ((err = start_i2c_gpio())) {
     LOG_ERROR("start_i2c_gpio");
@@ -154,25 +243,9 @@ void app_main(void)
   }
 #endif
 
-  LOG_INFO("setup");
-
-  if ((err = init_wifi())) {
-    LOG_ERROR("init_wifi");
-    user_alert(USER_ALERT_ERROR_SETUP);
-  }
-
-#if CONFIG_ETH_ENABLED
-  if ((err = init_eth())) {
-    LOG_ERROR("init_eth");
-    user_alert(USER_ALERT_ERROR_SETUP);
-  }
-#endif
-
-  if ((err = init_http())) {
-    LOG_ERROR("init_http");
-    user_alert(USER_ALERT_ERROR_SETUP);
-  }
+  LOG_INFO("outputs");
 
+  // outputs do not depend on the network, artnet metadata is updated once connected
   if ((err = init_atx_psu())) {
     LOG_ERROR("init_atx_psu");
     user_alert(USER_ALERT_ERROR_SETUP);
@@ -193,23 +266,11 @@ void app_main(void)
     user_alert(USER_ALERT_ERROR_SETUP);
   }
 
-  LOG_INFO("start");
+  // network setup runs in parallel with output startup
+  if ((err = start_boot_network())) {
+    LOG_WARN("start_boot_network: fallback to sequential network setup");
 
-  if ((err = start_wifi_boot())) {
-    LOG_ERROR("start_wifi_boot");
-    user_alert(USER_ALERT_ERROR_START);
-  }
-
-#if CONFIG_ETH_ENABLED
-  if ((err = start_eth())) {
-    LOG_ERROR("start_eth");
-    user_alert(USER_ALERT_ERROR_START);
-  }
-#endif
-
-  if ((err = start_http())) {
-    LOG_ERROR("start_http");
-    user_alert(USER_ALERT_ERROR_START);
+    boot_network();
   }
 
   if ((err = start_atx_psu())) {
@@ -222,6 +283,7 @@ void app_main(void)
     user_alert(USER_ALERT_ERROR_START);
   }
 
+  // outputs static color or sequence until artnet is active
   if ((err = start_leds())) {
     LOG_ERROR("start_leds");
     user_alert(USER_ALERT_ERROR_START);
@@ -233,6 +295,8 @@ void app_main(void)
     user_alert(USER_ALERT_ERROR_START);
   }
 
+  wait_boot_network();
+
   LOG_INFO("fini");
 
   if ((err = boot_config()) < 0) {
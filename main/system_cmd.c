@@ -1,7 +1,9 @@
 #include "system.h"
 
 #include <logging.h>
+#include <stats_bench.h>
 #include <system.h>
+#include <system_heap.h>
 #include <system_interfaces.h>
 #include <system_interfaces_print.h>
 #include <system_partition.h>
@@ -46,6 +48,7 @@ static int system_status_cmd(int argc, char **argv, void *ctx)
   printf("System:\n");
   printf("\tUptime: %u.%03us\n", status.uptime_s, status.uptime_us / 1000);
   printf("\tReset:  %s\n", esp_reset_reason_str(status.reset_reason));
+  printf("\tFrame:  %u.%03us\n", status.boot_frame_us / 1000000, status.boot_frame_us % 1000000 / 1000);
   printf("\n");
   printf("CPU:\n");
   printf("\tFreq:   %6dMhz\n", status.cpu_frequency / 1000 / 1000);
@@ -79,6 +82,35 @@ static int system_image_cmd(int argc, char **argv, void *ctx)
   return 0;
 }
 
+// current size of allocations per subsystem, not including heap overhead
+static int print_system_heap_usage(const struct system_heap_usage *usage, void *ctx)
+{
+  printf("\t%-16s: internal %8u external %8u bytes\n", usage->name, usage->internal_size, usage->external_size);
+
+  return 0;
+}
+
+static int system_heap_cmd(int argc, char **argv, void *ctx)
+{
+  printf("Heap regions:\n");
+
+  for (enum system_heap_caps caps = 0; caps < SYSTEM_HEAP_CAPS_MAX; caps++) {
+    struct system_heap_caps_info info;
+
+    if (system_heap_caps_info_get(caps, &info)) {
+      continue;
+    }
+
+    printf("\t%-16s: size %8u free %8u (min %8u) largest free block %8u bytes\n", system_heap_caps_str(caps),
+      info.total_size, info.free_size, info.minimum_free_size, info.largest_free_block
+    );
+  }
+
+  printf("Current heap usage (external RAM %s):\n", system_heap_external() ? "present" : "not present");
+
+  return system_heap_usage_walk(print_system_heap_usage, NULL);
+}
+
 static int system_partitions_cmd(int argc, char **argv, void *ctx)
 {
   esp_partition_iterator_t it;
@@ -228,14 +260,50 @@ static int system_restart_cmd(int argc, char **argv, void *ctx)
   system_restart();
 }
 
+#define SYSTEM_BENCH_ROUNDS 1000
+
+static void print_system_bench(const char *desc, const struct stats_timer *timer)
+{
+  printf("\t%-20s: %8u rounds %8.3fus/round %8.1fns/packet\n", desc,
+    timer->count,
+    stats_timer_average_seconds(timer) * 1000000.0f,
+    stats_timer_average_seconds(timer) * 1000000000.0f / STATS_BENCH_PACKETS
+  );
+}
+
+static int system_bench_cmd(int argc, char **argv, void *ctx)
+{
+  struct stats_bench_stats stats;
+  unsigned rounds = SYSTEM_BENCH_ROUNDS;
+  int err;
+
+  if ((argc > 1) && (err = cmd_arg_uint(argc, argv, 1, &rounds)))
+    return err;
+
+  if ((err = stats_bench(rounds, &stats))) {
+    LOG_ERROR("stats_bench");
+    return err;
+  }
+
+  printf("Stats: %u packets x 4 counters + 1 timer (lazy update %s)\n", STATS_BENCH_PACKETS, STATS_LAZY_UPDATE ? "enabled" : "disabled");
+
+  print_system_bench("clock",       &stats.clock);
+  print_system_bench("timestamped", &stats.timestamp);
+  print_system_bench("stats",       &stats.counter);
+
+  return 0;
+}
+
 static const struct cmd system_commands[] = {
   { "info",       system_info_cmd,        .describe = "Print system info" },
   { "image",      system_image_cmd,       .describe = "Print system image" },
   { "status",     system_status_cmd,      .describe = "Print system status" },
+  { "heap",       system_heap_cmd,        .describe = "Print heap regions and per-subsystem usage" },
   { "partitions", system_partitions_cmd,  .describe = "Print system partitions" },
   { "tasks",      system_tasks_cmd  ,     .describe = "Print system tasks" },
   { "interfaces", system_interfaces_cmd,  .describe = "Print system network interfaces" },
   { "restart",    system_restart_cmd,     .describe = "Restart system" },
+  { "bench",      system_bench_cmd,       .usage = "[ROUNDS]", .describe = "Benchmark stats instrumentation overhead" },
   {}
 };
 
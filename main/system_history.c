@@ -0,0 +1,352 @@
+#include "system_history.h"
+#include "artnet_state.h"
+#include "leds_stats.h"
+#include "tasks.h"
+
+#include <artnet_stats.h>
+#include <logging.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+struct system_history_state {
+  // protects history
+  SemaphoreHandle_t mutex;
+
+  // protects snapshot while being read
+  SemaphoreHandle_t snapshot_mutex;
+
+  // preallocated for uxTaskGetSystemState(), grown if more tasks are started
+  TaskStatus_t *task_status;
+  unsigned task_status_size;
+
+  uint32_t total_runtime;
+  uint32_t idle_runtime[SYSTEM_HISTORY_CORES];
+
+  uint32_t leds_late;
+  uint32_t artnet_drop;
+  struct artnet_stats artnet_stats;
+
+  struct system_history history;
+
+  // copied from history for system_history_read()
+  struct system_history snapshot;
+};
+
+static struct system_history_state *system_history_state;
+static TaskHandle_t system_history_task;
+
+// counters may be reset via the stats commands
+static inline uint32_t system_history_delta(uint32_t value, uint32_t last)
+{
+  return value >= last ? value - last : value;
+}
+
+static inline uint16_t system_history_permille(uint32_t runtime, uint32_t total)
+{
+  uint64_t permille = total ? (uint64_t) runtime * 1000 / total : 0;
+
+  return permille > UINT16_MAX ? UINT16_MAX : permille;
+}
+
+static int system_history_idle_core(const TaskStatus_t *t)
+{
+  if (strncmp(t->pcTaskName, "IDLE", 4)) {
+    return SYSTEM_HISTORY_CORE_NONE;
+  }
+
+#if configTASKLIST_INCLUDE_COREID
+  if (t->xCoreID >= 0 && t->xCoreID < SYSTEM_HISTORY_CORES) {
+    return t->xCoreID;
+  } else {
+    return SYSTEM_HISTORY_CORE_NONE;
+  }
+#else
+  return 0;
+#endif
+}
+
+static struct system_history_task *system_history_task_find(struct system_history *history, const TaskStatus_t *t)
+{
+  for (struct system_history_task *task = history->tasks; task < history->tasks + history->task_count; task++) {
+    if (task->number == t->xTaskNumber) {
+      return task;
+    }
+  }
+
+  return NULL;
+}
+
+/* Assign a new or inactive slot, clearing any usage of a deleted task from the older windows */
+static struct system_history_task *system_history_task_slot(struct system_history *history, const TaskStatus_t *t)
+{
+  struct system_history_task *task = NULL;
+
+  if (history->task_count < SYSTEM_HISTORY_TASKS) {
+    task = &history->tasks[history->task_count++];
+  } else {
+    for (struct system_history_task *slot = history->tasks; slot < history->tasks + history->task_count; slot++) {
+      if (!slot->active) {
+        task = slot;
+        break;
+      }
+    }
+
+    if (!task) {
+      return NULL;
+    }
+
+    for (struct system_history_window *window = history->windows; window < history->windows + SYSTEM_HISTORY_SIZE; window++) {
+      window->usage[task - history->tasks] = 0;
+    }
+  }
+
+  task->number = t->xTaskNumber;
+  task->runtime = t->ulRunTimeCounter;
+
+  strlcpy(task->name, t->pcTaskName, sizeof(task->name));
+
+#if configTASKLIST_INCLUDE_COREID
+  task->core = (t->xCoreID == tskNO_AFFINITY) ? SYSTEM_HISTORY_CORE_NONE : t->xCoreID;
+#else
+  task->core = SYSTEM_HISTORY_CORE_NONE;
+#endif
+
+  task->active = true;
+
+  return task;
+}
+
+static uint32_t system_history_leds_late()
+{
+  uint32_t count = 0;
+
+  for (int i = 0; i < LEDS_COUNT; i++) {
+    const struct leds_stats *stats = &leds_stats[i];
+
+    count += stats->sync_missed.count + stats->sync_timeout.count + stats->update_timeout.count;
+  }
+
+  return count;
+}
+
+static uint32_t system_history_artnet_drop(struct system_history_state *state)
+{
+  if (!artnet) {
+    return 0;
+  }
+
+  artnet_get_stats(artnet, &state->artnet_stats);
+
+  return state->artnet_stats.dmx_miss.count + state->artnet_stats.recv_overrun.count;
+}
+
+static int system_history_task_status_alloc(struct system_history_state *state, unsigned count)
+{
+  unsigned size = count + SYSTEM_HISTORY_TASK_STATUS_HEADROOM;
+  TaskStatus_t *task_status;
+
+  if (!(task_status = calloc(size, sizeof(*task_status)))) {
+    LOG_ERROR("calloc(%u)", size);
+    return -1;
+  }
+
+  free(state->task_status);
+
+  state->task_status = task_status;
+  state->task_status_size = size;
+
+  return 0;
+}
+
+static void system_history_sample(struct system_history_state *state)
+{
+  struct system_history *history = &state->history;
+  struct system_history_window *window;
+  uint32_t total_runtime, leds_late, artnet_drop;
+  unsigned count;
+
+  if ((count = uxTaskGetNumberOfTasks()) > state->task_status_size) {
+    LOG_WARN("grow task status buffer for %u tasks", count);
+
+    if (system_history_task_status_alloc(state, count)) {
+      return;
+    }
+  }
+
+  if (!(count = uxTaskGetSystemState(state->task_status, state->task_status_size, &total_runtime))) {
+    // tasks started since uxTaskGetNumberOfTasks(), retry on next sample
+    LOG_WARN("uxTaskGetSystemState: more than %u tasks", state->task_status_size);
+    return;
+  }
+
+  leds_late = system_history_leds_late();
+  artnet_drop = system_history_artnet_drop(state);
+
+  xSemaphoreTake(state->mutex, portMAX_DELAY);
+
+  window = &history->windows[history->window_index];
+  memset(window, 0, sizeof(*window));
+
+  window->tick = xTaskGetTickCount();
+  window->runtime = total_runtime - state->total_runtime;
+  window->leds_late = system_history_delta(leds_late, state->leds_late);
+  window->artnet_drop = system_history_delta(artnet_drop, state->artnet_drop);
+
+  for (struct system_history_task *task = history->tasks; task < history->tasks + history->task_count; task++) {
+    task->active = false;
+  }
+
+  // update listed tasks before assigning any new slots, so that only deleted tasks are reused
+  for (const TaskStatus_t *t = state->task_status; t < state->task_status + count; t++) {
+    struct system_history_task *task;
+    int core;
+
+    if ((core = system_history_idle_core(t)) >= 0) {
+      window->idle[core] = system_history_permille(t->ulRunTimeCounter - state->idle_runtime[core], window->runtime);
+      state->idle_runtime[core] = t->ulRunTimeCounter;
+
+    } else if ((task = system_history_task_find(history, t))) {
+      window->usage[task - history->tasks] = system_history_permille(t->ulRunTimeCounter - task->runtime, window->runtime);
+      task->runtime = t->ulRunTimeCounter;
+      task->active = true;
+    }
+  }
+
+  // new tasks establish their runtime baseline
+  for (const TaskStatus_t *t = state->task_status; t < state->task_status + count; t++) {
+    if (system_history_idle_core(t) >= 0 || system_history_task_find(history, t)) {
+      continue;
+    }
+
+    if (!system_history_task_slot(history, t)) {
+      LOG_DEBUG("no slot for task %s", t->pcTaskName);
+    }
+  }
+
+  // the first sample only establishes the baseline
+  if (state->total_runtime) {
+    history->window_index = (history->window_index + 1) % SYSTEM_HISTORY_SIZE;
+
+    if (history->window_count < SYSTEM_HISTORY_SIZE) {
+      history->window_count++;
+    }
+  }
+
+  xSemaphoreGive(state->mutex);
+
+  state->total_runtime = total_runtime;
+  state->leds_late = leds_late;
+  state->artnet_drop = artnet_drop;
+}
+
+static void system_history_main(void *arg)
+{
+  struct system_history_state *state = arg;
+  TickType_t tick = xTaskGetTickCount();
+
+  for (;;) {
+    system_history_sample(state);
+
+    vTaskDelayUntil(&tick, SYSTEM_HISTORY_PERIOD_MS / portTICK_PERIOD_MS);
+  }
+}
+
+int init_system_history()
+{
+  struct system_history_state *state;
+
+  if (!(state = calloc(1, sizeof(*state)))) {
+    LOG_ERROR("calloc");
+    return -1;
+  }
+
+  // leave headroom for tasks started later, avoiding allocations when sampling
+  if (system_history_task_status_alloc(state, uxTaskGetNumberOfTasks())) {
+    goto error;
+  }
+
+  if (!(state->mutex = xSemaphoreCreateMutex())) {
+    LOG_ERROR("xSemaphoreCreateMutex");
+    goto error;
+  }
+
+  if (!(state->snapshot_mutex = xSemaphoreCreateMutex())) {
+    LOG_ERROR("xSemaphoreCreateMutex");
+    goto error;
+  }
+
+  system_history_state = state;
+
+  return 0;
+
+error:
+  if (state->mutex) {
+    vSemaphoreDelete(state->mutex);
+  }
+
+  free(state->task_status);
+  free(state);
+
+  return -1;
+}
+
+int start_system_history()
+{
+  struct task_options task_options = {
+    .main       = system_history_main,
+    .name       = SYSTEM_HISTORY_TASK_NAME,
+    .stack_size = SYSTEM_HISTORY_TASK_STACK,
+    .arg        = system_history_state,
+    .priority   = SYSTEM_HISTORY_TASK_PRIORITY,
+    .handle     = &system_history_task,
+    .affinity   = SYSTEM_HISTORY_TASK_AFFINITY,
+  };
+  int err;
+
+  if (!system_history_state) {
+    LOG_WARN("not initialized");
+    return 1;
+  }
+
+  if ((err = start_task(task_options))) {
+    LOG_ERROR("start_task[%s]", SYSTEM_HISTORY_TASK_NAME);
+    return err;
+  }
+
+  return 0;
+}
+
+bool system_history_enabled()
+{
+  return system_history_state != NULL;
+}
+
+int system_history_read(int (*func)(const struct system_history *history, void *ctx), void *ctx)
+{
+  struct system_history_state *state = system_history_state;
+  int ret;
+
+  if (!state) {
+    return 1;
+  }
+
+  xSemaphoreTake(state->snapshot_mutex, portMAX_DELAY);
+
+  // only hold the sampling mutex for the copy, not while func writes out the snapshot
+  xSemaphoreTake(state->mutex, portMAX_DELAY);
+
+  state->snapshot = state->history;
+
+  xSemaphoreGive(state->mutex);
+
+  ret = func(&state->snapshot, ctx);
+
+  xSemaphoreGive(state->snapshot_mutex);
+
+  return ret;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SYSTEM_HISTORY_PERIOD_MS 1000
+#define SYSTEM_HISTORY_TASKS 32
+
+// uxTaskGetSystemState() buffer headroom over the current number of tasks, for tasks started later
+#define SYSTEM_HISTORY_TASK_STATUS_HEADROOM 8
+
+#if CONFIG_IDF_TARGET_ESP8266
+# define SYSTEM_HISTORY_SIZE 10
+#elif CONFIG_IDF_TARGET_ESP32
+# define SYSTEM_HISTORY_SIZE 30
+#endif
+
+#ifdef portNUM_PROCESSORS
+# define SYSTEM_HISTORY_CORES portNUM_PROCESSORS
+#else
+# define SYSTEM_HISTORY_CORES 1
+#endif
+
+#define SYSTEM_HISTORY_CORE_NONE -1
+
+struct system_history_task {
+  UBaseType_t number;
+  char name[configMAX_TASK_NAME_LEN];
+  int core; // SYSTEM_HISTORY_CORE_NONE if not pinned
+
+  // runtime counter at last sample
+  uint32_t runtime;
+
+  // listed in the most recent sample, slot may be reused for a new task if not
+  bool active;
+};
+
+struct system_history_window {
+  TickType_t tick;
+
+  // total runtime elapsed over window
+  uint32_t runtime;
+
+  // per-mille of window runtime
+  uint16_t idle[SYSTEM_HISTORY_CORES];
+  uint16_t usage[SYSTEM_HISTORY_TASKS];
+
+  // sum of leds sync missed/timeout + update timeouts over window
+  uint32_t leds_late;
+
+  // sum of artnet dmx miss + socket overruns over window
+  uint32_t artnet_drop;
+};
+
+struct system_history {
+  // tracked tasks, slots are assigned in order of first appearance, and reused once a task is deleted
+  struct system_history_task tasks[SYSTEM_HISTORY_TASKS];
+  unsigned task_count;
+
+  // ring buffer of windows
+  struct system_history_window windows[SYSTEM_HISTORY_SIZE];
+  unsigned window_count, window_index;
+};
+
+int init_system_history();
+int start_system_history();
+
+/*
+ * Return window by age, with 0 being the oldest window and `history->window_count - 1` the most recent.
+ */
+static inline const struct system_history_window *system_history_window(const struct system_history *history, unsigned i)
+{
+  return &history->windows[(history->window_index + SYSTEM_HISTORY_SIZE - history->window_count + i) % SYSTEM_HISTORY_SIZE];
+}
+
+/*
+ * Sampling has been initialized.
+ */
+bool system_history_enabled();
+
+/*
+ * Call func with a snapshot of the history, without blocking the sampling while func runs.
+ *
+ * Returns 1 if not initialized, or the return value of func.
+ */
+int system_history_read(int (*func)(const struct system_history *history, void *ctx), void *ctx);
@@ -1,10 +1,15 @@
+#include "http.h"
 #include "system.h"
+#include "system_history.h"
+#include "user.h"
+#include "user_log.h"
 #include "http_routes.h"
 #include "http_handlers.h"
 
 #include <logging.h>
 #include <json.h>
 #include <system.h>
+#include <system_heap.h>
 #include <system_interfaces.h>
 #include <system_partition.h>
 #include <system_tasks.h>
@@ -15,6 +20,7 @@
 #include <freertos/task.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #if CONFIG_IDF_TARGET_ESP8266
@@ -23,6 +29,36 @@
 # include <json_netif.h>
 #endif
 
+// uxTaskGetSystemState() buffer headroom over the current number of tasks, for tasks started later
+#define SYSTEM_API_TASKS_HEADROOM 8
+
+// preallocated for uxTaskGetSystemState(), requests are serialized by http_server_lock()
+static TaskStatus_t *system_api_tasks;
+static unsigned system_api_tasks_size;
+
+static int system_api_tasks_alloc(unsigned count)
+{
+  unsigned size = count + SYSTEM_API_TASKS_HEADROOM;
+  TaskStatus_t *tasks;
+
+  if (!(tasks = calloc(size, sizeof(*tasks)))) {
+    LOG_ERROR("calloc(%u)", size);
+    return -1;
+  }
+
+  free(system_api_tasks);
+
+  system_api_tasks = tasks;
+  system_api_tasks_size = size;
+
+  return 0;
+}
+
+int init_system_http()
+{
+  return system_api_tasks_alloc(uxTaskGetNumberOfTasks());
+}
+
 static int system_api_write_info_object(struct json_writer *w)
 {
   struct system_info info;
@@ -55,6 +91,30 @@ static int system_api_write_info_object(struct json_writer *w)
   );
 }
 
+static int system_api_write_heap_caps_object(struct json_writer *w)
+{
+  int err;
+
+  for (enum system_heap_caps caps = 0; caps < SYSTEM_HEAP_CAPS_MAX; caps++) {
+    struct system_heap_caps_info info;
+
+    if (system_heap_caps_info_get(caps, &info)) {
+      continue;
+    }
+
+    if ((err = JSON_WRITE_MEMBER_OBJECT(w, system_heap_caps_str(caps),
+          JSON_WRITE_MEMBER_UINT(w, "size", info.total_size)
+      ||  JSON_WRITE_MEMBER_UINT(w, "free", info.free_size)
+      ||  JSON_WRITE_MEMBER_UINT(w, "free_min", info.minimum_free_size)
+      ||  JSON_WRITE_MEMBER_UINT(w, "free_block_max", info.largest_free_block)
+    ))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
 static int system_api_write_status_object(struct json_writer *w)
 {
   struct system_status status;
@@ -69,10 +129,28 @@ static int system_api_write_status_object(struct json_writer *w)
     JSON_WRITE_MEMBER_UINT(w, "heap_size", status.total_heap_size) ||
     JSON_WRITE_MEMBER_UINT(w, "heap_free", status.free_heap_size) ||
     JSON_WRITE_MEMBER_UINT(w, "heap_free_min", status.minimum_free_heap_size) ||
-    JSON_WRITE_MEMBER_UINT(w, "heap_free_max", status.maximum_free_heap_size)
+    JSON_WRITE_MEMBER_UINT(w, "heap_free_max", status.maximum_free_heap_size) ||
+    JSON_WRITE_MEMBER_OBJECT(w, "heap_caps", system_api_write_heap_caps_object(w)) ||
+    JSON_WRITE_MEMBER_UINT(w, "boot_frame_us", status.boot_frame_us)
+  );
+}
+
+static int system_api_write_heap_usage_object(const struct system_heap_usage *usage, void *ctx)
+{
+  struct json_writer *w = ctx;
+
+  return JSON_WRITE_OBJECT(w,
+    JSON_WRITE_MEMBER_STRING(w, "name", usage->name) ||
+    JSON_WRITE_MEMBER_UINT(w, "internal", usage->internal_size) ||
+    JSON_WRITE_MEMBER_UINT(w, "external", usage->external_size)
   );
 }
 
+static int system_api_write_heap_usage_array(struct json_writer *w)
+{
+  return system_heap_usage_walk(system_api_write_heap_usage_object, w);
+}
+
 static int system_api_write_partition_object(struct json_writer *w, const esp_partition_t *p)
 {
   const char *type = esp_partition_type_str(p->type);
@@ -118,7 +196,7 @@ static int system_api_write_task_object(struct json_writer *w, const TaskStatus_
     JSON_WRITE_MEMBER_UINT(w, "number", t->xTaskNumber) ||
     JSON_WRITE_MEMBER_STRING(w, "state", system_task_state_str(t->eCurrentState)) ||
 #if configTASKLIST_INCLUDE_COREID
-    (t->xCoreID == tskNO_AFFINITY ? JSON_WRITE_MEMBER_UINT(w, "core_id", t->xCoreID) : JSON_WRITE_MEMBER_NULL(w, "core_id")) ||
+    (t->xCoreID == tskNO_AFFINITY ? JSON_WRITE_MEMBER_NULL(w, "core_id") : JSON_WRITE_MEMBER_UINT(w, "core_id", t->xCoreID)) ||
 #endif
     JSON_WRITE_MEMBER_UINT(w, "current_priority", t->uxCurrentPriority) ||
     JSON_WRITE_MEMBER_UINT(w, "base_priority", t->uxCurrentPriority) ||
@@ -129,37 +207,54 @@ static int system_api_write_task_object(struct json_writer *w, const TaskStatus_
   );
 }
 
-static int system_api_write_tasks_array(struct json_writer *w)
+/* Returns number of tasks, or 0 if not available */
+static unsigned system_api_tasks_get(uint32_t *total_runtimep)
 {
-  unsigned count = uxTaskGetNumberOfTasks();
-  TaskStatus_t *tasks;
-  uint32_t total_runtime;
-  int err = 0;
+  unsigned count;
 
-  if (!(tasks = calloc(count, sizeof(*tasks)))) {
-    LOG_ERROR("calloc");
-    return -1;
+  if ((count = uxTaskGetNumberOfTasks()) > system_api_tasks_size) {
+    LOG_WARN("grow tasks buffer for %u tasks", count);
+
+    if (system_api_tasks_alloc(count)) {
+      return 0;
+    }
   }
 
-  if (!(count = uxTaskGetSystemState(tasks, count, &total_runtime))) {
-    err = -1;
-    LOG_ERROR("uxTaskGetSystemState");
-    goto error;
+  if (!(count = uxTaskGetSystemState(system_api_tasks, system_api_tasks_size, total_runtimep))) {
+    LOG_WARN("uxTaskGetSystemState: more than %u tasks", system_api_tasks_size);
+    return 0;
   }
 
+  return count;
+}
+
+static int system_api_write_tasks_array(struct json_writer *w, unsigned count, uint32_t total_runtime)
+{
+  int err;
+
   for (unsigned i = 0; i < count; i++) {
-    TaskStatus_t *t = &tasks[i];
+    TaskStatus_t *t = &system_api_tasks[i];
 
     if ((err = JSON_WRITE_OBJECT(w, system_api_write_task_object(w, t, total_runtime)))) {
       LOG_ERROR("system_api_write_task_object");
-      goto error;
+      return err;
     }
   }
 
-error:
-  free(tasks);
+  return 0;
+}
 
-  return err;
+/* Write null tasks if not available, without failing the entire response */
+static int system_api_write_tasks_member(struct json_writer *w)
+{
+  uint32_t total_runtime;
+  unsigned count;
+
+  if (!(count = system_api_tasks_get(&total_runtime))) {
+    return JSON_WRITE_MEMBER_NULL(w, "tasks");
+  }
+
+  return JSON_WRITE_MEMBER_ARRAY(w, "tasks", system_api_write_tasks_array(w, count, total_runtime));
 }
 
 static int system_api_write_interface_object(const struct system_interface_info *info, void *ctx)
@@ -188,20 +283,138 @@ static int system_api_write_interfaces_object(struct json_writer *w)
   return system_interface_walk(system_api_write_interface_object, w);
 }
 
+static int system_api_write_activity_object(struct json_writer *w)
+{
+  TickType_t tick = xTaskGetTickCount();
+  int err;
+
+  for (enum user_activity a = USER_ACTIVITY_IDLE + 1; a < USER_ACTIVITY_MAX; a++) {
+    const struct user_activity_stats *stats = &user_activity_stats[a];
+
+    if (!stats->count) {
+      continue;
+    }
+
+    if ((err = JSON_WRITE_MEMBER_OBJECT(w, user_activity_str(a),
+          JSON_WRITE_MEMBER_UINT(w, "tick_ms", (tick - stats->tick) * portTICK_RATE_MS)
+      ||  JSON_WRITE_MEMBER_UINT(w, "count", stats->count)
+      ||  JSON_WRITE_MEMBER_UINT(w, "rate_percent", stats->window_rate * 100 / USER_ACTIVITY_WINDOW)
+    ))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
 static int system_api_write(struct json_writer *w, void *ctx)
 {
   return JSON_WRITE_OBJECT(w,
     JSON_WRITE_MEMBER_OBJECT(w, "info", system_api_write_info_object(w)) ||
     JSON_WRITE_MEMBER_OBJECT(w, "status", system_api_write_status_object(w)) ||
+    JSON_WRITE_MEMBER_ARRAY(w, "heap_usage", system_api_write_heap_usage_array(w)) ||
     JSON_WRITE_MEMBER_ARRAY(w, "partitions", system_api_write_partitions_array(w)) ||
-    JSON_WRITE_MEMBER_ARRAY(w, "tasks", system_api_write_tasks_array(w)) ||
-    JSON_WRITE_MEMBER_OBJECT(w, "interfaces", system_api_write_interfaces_object(w))
+    system_api_write_tasks_member(w) ||
+    JSON_WRITE_MEMBER_OBJECT(w, "interfaces", system_api_write_interfaces_object(w)) ||
+    JSON_WRITE_MEMBER_OBJECT(w, "activity", system_api_write_activity_object(w))
   );
 }
 
 static int system_api_write_tasks(struct json_writer *w, void *ctx)
 {
-  return JSON_WRITE_ARRAY(w, system_api_write_tasks_array(w));
+  uint32_t total_runtime;
+  unsigned count;
+
+  if (!(count = system_api_tasks_get(&total_runtime))) {
+    return json_write_null(w);
+  }
+
+  return JSON_WRITE_ARRAY(w, system_api_write_tasks_array(w, count, total_runtime));
+}
+
+static int system_api_write_history_cores(struct json_writer *w, const struct system_history_window *window)
+{
+  int err;
+
+  for (unsigned core = 0; core < SYSTEM_HISTORY_CORES; core++) {
+    if ((err = json_write_uint(w, window->idle[core]))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+static int system_api_write_history_usage(struct json_writer *w, const struct system_history *history, const struct system_history_window *window)
+{
+  int err;
+
+  for (unsigned i = 0; i < history->task_count; i++) {
+    if ((err = json_write_uint(w, window->usage[i]))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+static int system_api_write_history_windows(struct json_writer *w, const struct system_history *history)
+{
+  TickType_t tick = xTaskGetTickCount();
+  int err;
+
+  for (unsigned i = 0; i < history->window_count; i++) {
+    const struct system_history_window *window = system_history_window(history, i);
+
+    if ((err = JSON_WRITE_OBJECT(w,
+          JSON_WRITE_MEMBER_UINT(w, "tick_ms", (tick - window->tick) * portTICK_RATE_MS)
+      ||  JSON_WRITE_MEMBER_UINT(w, "runtime", window->runtime)
+      ||  JSON_WRITE_MEMBER_ARRAY(w, "idle", system_api_write_history_cores(w, window))
+      ||  JSON_WRITE_MEMBER_ARRAY(w, "usage", system_api_write_history_usage(w, history, window))
+      ||  JSON_WRITE_MEMBER_UINT(w, "leds_late", window->leds_late)
+      ||  JSON_WRITE_MEMBER_UINT(w, "artnet_drop", window->artnet_drop)
+    ))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+static int system_api_write_history_tasks(struct json_writer *w, const struct system_history *history)
+{
+  int err;
+
+  for (unsigned i = 0; i < history->task_count; i++) {
+    const struct system_history_task *task = &history->tasks[i];
+
+    if ((err = JSON_WRITE_OBJECT(w,
+          JSON_WRITE_MEMBER_STRING(w, "name", task->name)
+      ||  (task->core == SYSTEM_HISTORY_CORE_NONE ? JSON_WRITE_MEMBER_NULL(w, "core_id") : JSON_WRITE_MEMBER_UINT(w, "core_id", task->core))
+    ))) {
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+static int system_api_write_history_object(const struct system_history *history, void *ctx)
+{
+  struct json_writer *w = ctx;
+
+  return JSON_WRITE_OBJECT(w,
+    JSON_WRITE_MEMBER_UINT(w, "period_ms", SYSTEM_HISTORY_PERIOD_MS) ||
+    JSON_WRITE_MEMBER_UINT(w, "cores", SYSTEM_HISTORY_CORES) ||
+    JSON_WRITE_MEMBER_ARRAY(w, "tasks", system_api_write_history_tasks(w, history)) ||
+    JSON_WRITE_MEMBER_ARRAY(w, "windows", system_api_write_history_windows(w, history))
+  );
+}
+
+static int system_api_write_history(struct json_writer *w, void *ctx)
+{
+  // serialize directly from the sampler ring buffer, without copying
+  return system_history_read(system_api_write_history_object, w);
 }
 
 int system_api_handler(struct http_request *request, struct http_response *response, void *ctx)
@@ -238,6 +451,28 @@ int system_api_tasks_handler(struct http_request *request, struct http_response
   return 0;
 }
 
+int system_api_history_handler(struct http_request *request, struct http_response *response, void *ctx)
+{
+  int err;
+
+  if ((err = http_request_headers(request, NULL))) {
+    LOG_WARN("http_request_headers");
+    return err;
+  }
+
+  if (!system_history_enabled()) {
+    // disabled
+    return HTTP_NO_CONTENT;
+  }
+
+  if ((err = write_http_response_json(response, system_api_write_history, NULL))) {
+    LOG_WARN("write_http_response_json -> system_api_write_history");
+    return err;
+  }
+
+  return 0;
+}
+
 int system_api_restart_handler(struct http_request *request, struct http_response *response, void *ctx)
 {
   int err;
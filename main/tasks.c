@@ -1,4 +1,5 @@
 #include "tasks.h"
+#include "tasks_config.h"
 
 #include <logging.h>
 
@@ -21,8 +22,22 @@
     return 0;
   }
 #elif CONFIG_IDF_TARGET_ESP32
+  static BaseType_t task_affinity(BaseType_t affinity)
+  {
+    // tasks started before init_config() use the default split
+    if (tasks_config.affinity == TASKS_AFFINITY_NONE) {
+      return tskNO_AFFINITY;
+    }
+
+    return affinity;
+  }
+
   int start_task(struct task_options options)
   {
+    options.affinity = task_affinity(options.affinity);
+
+    LOG_DEBUG("%s: priority=%u affinity=%d", options.name, options.priority, options.affinity);
+
     if (xTaskCreatePinnedToCore(
       options.main,
       options.name,
@@ -22,10 +22,20 @@ int start_taskf(struct task_options options, ...);
 # define TASKS_CPU_PRO -1
 # define TASKS_CPU_APP -1
 
+# define TASKS_AFFINITY_SUPPORTED 0
+
 #elif CONFIG_IDF_TARGET_ESP32
 # define TASKS_CPU_PRO 0 // used for networking and management
 # define TASKS_CPU_APP 1 // used for performance-critical tasks
 
+# define TASKS_AFFINITY_SUPPORTED 1
+
+#endif
+
+#if TASKS_AFFINITY_SUPPORTED
+  #include <config.h>
+
+  extern const struct configtab tasks_configtab[];
 #endif
 
 // used for leds interfaces
@@ -82,6 +92,13 @@ int start_taskf(struct task_options options, ...);
 
 #define LEDS_SEQUENCE_TASK_STACK 2048
 
+// used for SD-Card fseq read-ahead
+#define LEDS_SEQUENCE_READ_TASK_NAME "leds-seq-read"
+#define LEDS_SEQUENCE_READ_TASK_PRIORITY (tskIDLE_PRIORITY + 10)
+#define LEDS_SEQUENCE_READ_TASK_AFFINITY TASKS_CPU_PRO
+
+#define LEDS_SEQUENCE_READ_TASK_STACK 2048
+
 // used for TCP/IP ArtNET network protocol -> output
 #define ARTNET_LISTEN_TASK_NAME "artnet-listen"
 #define ARTNET_LISTEN_TASK_PRIORITY (tskIDLE_PRIORITY + 10)
@@ -89,6 +106,13 @@ int start_taskf(struct task_options options, ...);
 
 #define ARTNET_LISTEN_TASK_STACK 2048
 
+// used for ArtPoll -> ArtPollReply, below artnet-listen to avoid delaying ArtDmx
+#define ARTNET_POLL_TASK_NAME "artnet-poll"
+#define ARTNET_POLL_TASK_PRIORITY (tskIDLE_PRIORITY + 4)
+#define ARTNET_POLL_TASK_AFFINITY TASKS_CPU_PRO
+
+#define ARTNET_POLL_TASK_STACK 2048
+
 // used for handling user events
 #define USER_EVENTS_TASK_NAME  "user-events"  // max 16 chars
 #define USER_EVENTS_TASK_PRIORITY (tskIDLE_PRIORITY + 6)
@@ -133,8 +157,20 @@ int start_taskf(struct task_options options, ...);
 # define CONSOLE_CLI_TASK_STACK 4096 // bytes
 #endif
 
+// periodic task CPU usage sampling
+#define SYSTEM_HISTORY_TASK_NAME "system-history"
+#define SYSTEM_HISTORY_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+#define SYSTEM_HISTORY_TASK_AFFINITY TASKS_CPU_PRO
+#define SYSTEM_HISTORY_TASK_STACK 2048
+
+// network setup at boot, in parallel with outputs
+#define BOOT_NETWORK_TASK_NAME "boot-network"
+#define BOOT_NETWORK_TASK_PRIORITY (tskIDLE_PRIORITY + 1)
+#define BOOT_NETWORK_TASK_AFFINITY TASKS_CPU_PRO
+#define BOOT_NETWORK_TASK_STACK 4096
+
 // network configuration and management, socket IO and API handlers
-#define HTTP_SERVER_TASK_NAME "http-server"
+#define HTTP_SERVER_TASK_NAME_FMT "http-server%u"
 #define HTTP_SERVER_TASK_PRIORITY (tskIDLE_PRIORITY + 3)
 #define HTTP_SERVER_TASK_AFFINITY TASKS_CPU_PRO
 
@@ -0,0 +1,24 @@
+#include "tasks.h"
+#include "tasks_config.h"
+
+#if TASKS_AFFINITY_SUPPORTED
+struct tasks_config tasks_config = {};
+
+const struct config_enum tasks_affinity_enum[] = {
+  { "SPLIT",  .value = TASKS_AFFINITY_SPLIT  },
+  { "NONE",   .value = TASKS_AFFINITY_NONE   },
+  {}
+};
+
+const struct configtab tasks_configtab[] = {
+  { CONFIG_TYPE_ENUM, "affinity",
+    .description = (
+      "CPU affinity for tasks started after boot.\n"
+      "\tSPLIT -> Network, HTTP and console tasks on the PRO CPU, LEDs/DMX output tasks on the APP CPU.\n"
+      "\tNONE  -> No tasks are pinned, the scheduler may run any task on either CPU.\n"
+    ),
+    .enum_type = { .value = &tasks_config.affinity, .values = tasks_affinity_enum, .default_value = TASKS_AFFINITY_SPLIT },
+  },
+  {}
+};
+#endif
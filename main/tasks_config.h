@@ -0,0 +1,20 @@
+#pragma once
+
+#include "tasks.h"
+
+#include <config.h>
+
+enum tasks_affinity {
+  // pin networking/management tasks to TASKS_CPU_PRO, and output tasks to TASKS_CPU_APP
+  TASKS_AFFINITY_SPLIT,
+
+  // do not pin any tasks, allowing the scheduler to run them on either CPU
+  TASKS_AFFINITY_NONE,
+};
+
+struct tasks_config {
+  int affinity;
+};
+
+extern struct tasks_config tasks_config;
+extern const struct config_enum tasks_affinity_enum[];
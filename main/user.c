@@ -12,6 +12,10 @@ struct user_log user_state_log;
 struct user_log user_activity_log;
 struct user_log user_alert_log;
 
+volatile bool user_activity_flags[USER_ACTIVITY_MAX];
+struct user_activity_stats user_activity_stats[USER_ACTIVITY_MAX];
+static unsigned user_activity_window;
+
 const char *user_power_str(enum user_power power)
 {
   switch (power) {
@@ -129,22 +133,48 @@ void user_state(enum user_state state)
   set_user_leds_state(state);
 }
 
-void user_activity(enum user_activity activity)
+void user_activity_update()
 {
-  const char *str = user_activity_str(activity);
+  TickType_t tick = xTaskGetTickCount();
+  enum user_activity activity = USER_ACTIVITY_IDLE;
+  bool window = (++user_activity_window >= USER_ACTIVITY_WINDOW);
 
-  // activity is expected to be verbose
-  if (str) {
-    LOG_DEBUG("%s", str);
-  } else {
-    LOG_DEBUG("%05x", activity);
+  for (enum user_activity a = USER_ACTIVITY_IDLE + 1; a < USER_ACTIVITY_MAX; a++) {
+    struct user_activity_stats *stats = &user_activity_stats[a];
+
+    if (user_activity_flags[a]) {
+      user_activity_flags[a] = false;
+
+      stats->tick = tick;
+      stats->count++;
+      stats->window_count++;
+
+      activity = a;
+    }
+
+    if (window) {
+      stats->window_rate = stats->window_count;
+      stats->window_count = 0;
+    }
   }
 
+  if (window) {
+    user_activity_window = 0;
+  }
+
+  if (!activity) {
+    return;
+  }
+
+  // activity is expected to be verbose
+  LOG_DEBUG("%s", user_activity_str(activity));
+
   user_activity_log = (struct user_log) {
-    .tick     = xTaskGetTickCount(),
+    .tick     = tick,
     .activity = activity,
   };
 
+  // at most one flash per period, regardless of the number of sources or frames
   set_user_leds_activity(activity);
 }
 
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <freertos/FreeRTOS.h>
+
+#include <stdbool.h>
+
 enum user_power {
   USER_POWER_INIT = 0,
 
@@ -66,9 +70,29 @@ int init_user();
 
 void user_power(enum user_power power);
 void user_state(enum user_state state);
-void user_activity(enum user_activity activity);
 void user_alert(enum user_alert alert);
 
+/*
+ * Mark activity for source, called for every frame.
+ *
+ * This is only a single store, the activity is coalesced by user_activity_update() at USER_ACTIVITY_PERIOD.
+ */
+extern volatile bool user_activity_flags[USER_ACTIVITY_MAX];
+
+static inline void user_activity(enum user_activity activity)
+{
+  user_activity_flags[activity] = true;
+}
+
+// update period for coalescing activity
+#define USER_ACTIVITY_PERIOD (100 / portTICK_RATE_MS)
+
+// number of update periods for user_activity_stats window_rate
+#define USER_ACTIVITY_WINDOW 10
+
+/* Coalesce activity flags into user_activity_log/stats and flash the activity LED, called from the user-events task */
+void user_activity_update();
+
 // user_buttons.c
 void user_config_boot();
 void user_config_press();
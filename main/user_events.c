@@ -1,4 +1,5 @@
 #include <user_leds.h>
+#include "user.h"
 #include "user_leds.h"
 #include "user_leds_config.h"
 #include "user_leds_input.h"
@@ -156,15 +157,26 @@ int init_user_events()
 
 void user_events_main(void *arg)
 {
+  TickType_t activity_tick = xTaskGetTickCount();
+
   for (;;) {
     struct user_leds_input input;
+    TickType_t tick = xTaskGetTickCount();
+    TickType_t timeout = 0;
+
+    if (tick - activity_tick < USER_ACTIVITY_PERIOD) {
+      timeout = USER_ACTIVITY_PERIOD - (tick - activity_tick);
+    }
 
-    if (read_user_leds_input(&input, portMAX_DELAY)) {
-      LOG_DEBUG("timeout");
-      continue;
+    if (!read_user_leds_input(&input, timeout)) {
+      on_user_input(input);
     }
 
-    on_user_input(input);
+    if (xTaskGetTickCount() - activity_tick >= USER_ACTIVITY_PERIOD) {
+      user_activity_update();
+
+      activity_tick = xTaskGetTickCount();
+    }
   }
 }
 
@@ -20,3 +20,16 @@ extern struct user_log user_state_log;
 extern struct user_log user_activity_log;
 extern struct user_log user_alert_log;
 
+
+/* Coalesced per-source activity, updated by user_activity_update() */
+struct user_activity_stats {
+  TickType_t tick;
+
+  // total number of update periods with activity
+  unsigned count;
+
+  // number of active update periods within the current/previous window
+  unsigned window_count, window_rate;
+};
+
+extern struct user_activity_stats user_activity_stats[USER_ACTIVITY_MAX];
@@ -1,3 +1,4 @@
+#include "config.h"
 #include "config_vfs.h"
 #include "http_routes.h"
 #include "http_handlers.h"
@@ -221,6 +222,24 @@ static int vfs_http_rmdir(const struct vfs_http_params *params)
   return 0;
 }
 
+/* The config cache only checks the size/mtime of the .ini file, which a PUT with Last-Modified may preserve */
+static void vfs_http_config_invalidate(const struct vfs_http_params *params)
+{
+  const char *suffix;
+
+  if (strcmp(params->mount->path, CONFIG_VFS_PATH)) {
+    return;
+  }
+
+  if (!(suffix = strrchr(params->name, '.')) || strcmp(suffix + 1, CONFIG_FILE_EXT)) {
+    return;
+  }
+
+  if (config_delete_cache(&config, params->name) < 0) {
+    LOG_WARN("config_delete_cache %s", params->name);
+  }
+}
+
 static int vfs_http_unlink(const struct vfs_http_params *params)
 {
   if (params->type != VFS_HTTP_TYPE_FILE) {
@@ -229,6 +248,8 @@ static int vfs_http_unlink(const struct vfs_http_params *params)
 
   LOG_INFO("%s", params->path);
 
+  vfs_http_config_invalidate(params);
+
   if (unlink(params->path)) {
     return vfs_http_error("unlink", params->path);
   }
@@ -349,6 +370,10 @@ static int vfs_http_write(struct http_request *request, const struct vfs_http_pa
 
   LOG_INFO("path=%s mtime=%ld", params->path, params->mtime);
 
+  if (params->type == VFS_HTTP_TYPE_FILE) {
+    vfs_http_config_invalidate(params);
+  }
+
   if ((err = vfs_http_open(&file, params, "w")) < 0) {
     LOG_ERROR("vfs_http_open");
     return err;
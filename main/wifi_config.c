@@ -2,6 +2,7 @@
 #include "wifi_config.h"
 #include "wifi_interface.h"
 #include "wifi_state.h"
+#include "artnet_config.h"
 
 #include <logging.h>
 #include <system_wifi.h>
@@ -18,6 +19,7 @@
 #define WIFI_CONFIG_ENABLED_DEFAULT true
 #define WIFI_CONFIG_MODE_DEFAULT WIFI_MODE_AP
 #define WIFI_CONFIG_AUTHMODE_DEFAULT WIFI_AUTH_WPA2_PSK
+#define WIFI_CONFIG_POWER_SAVE_AUTO -1
 
 #define WIFI_SSID_FMT "qmsk-esp-%02x%02x%02x"
 #define WIFI_HOSTNAME_FMT "qmsk-esp-%02x%02x%02x"
@@ -46,6 +48,14 @@ const struct config_enum wifi_auth_mode_enum[] = {
   {}
 };
 
+const struct config_enum wifi_power_save_enum[] = {
+  { "",     .value = WIFI_CONFIG_POWER_SAVE_AUTO },
+  { "NONE", .value = WIFI_PS_NONE },
+  { "MIN",  .value = WIFI_PS_MIN_MODEM },
+  { "MAX",  .value = WIFI_PS_MAX_MODEM },
+  {}
+};
+
 const struct configtab wifi_configtab[] = {
   { CONFIG_TYPE_BOOL, "enabled",
     .description = (
@@ -69,6 +79,14 @@ const struct configtab wifi_configtab[] = {
     ),
     .enum_type = { .value = &wifi_config.auth_mode, .values = wifi_auth_mode_enum, .default_value = WIFI_CONFIG_AUTHMODE_DEFAULT },
   },
+  { CONFIG_TYPE_ENUM, "power_save",
+    .description = (
+      "For STA mode: modem power save mode.\n"
+      "Power save delays packet reception until the next AP beacon, causing latency spikes and dropped Art-Net packets.\n"
+      "Default is NONE if Art-Net is enabled, otherwise MIN.\n"
+    ),
+    .enum_type = { .value = &wifi_config.power_save, .values = wifi_power_save_enum, .default_value = WIFI_CONFIG_POWER_SAVE_AUTO },
+  },
   { CONFIG_TYPE_UINT16, "channel",
     .description = (
       "For STA mode: connect to AP with given SSID\n"
@@ -321,8 +339,38 @@ static int config_wifi_ap(const struct wifi_config *config)
   return 0;
 }
 
+static int config_wifi_power_save(const struct wifi_config *config)
+{
+  wifi_ps_type_t ps_type;
+  esp_err_t err;
+
+  if (config->power_save != WIFI_CONFIG_POWER_SAVE_AUTO) {
+    ps_type = config->power_save;
+  } else if (artnet_config.enabled) {
+    ps_type = WIFI_PS_NONE;
+  } else {
+    ps_type = WIFI_PS_MIN_MODEM;
+  }
+
+  LOG_INFO("power_save=%s", config_enum_to_string(wifi_power_save_enum, ps_type) ?: "?");
+
+  if ((err = esp_wifi_set_ps(ps_type))) {
+    LOG_ERROR("esp_wifi_set_ps: %s", esp_err_to_name(err));
+    return -1;
+  }
+
+  return 0;
+}
+
 int config_wifi(const struct wifi_config *config)
 {
+  int err;
+
+  if ((err = config_wifi_power_save(config))) {
+    LOG_ERROR("config_wifi_power_save");
+    return err;
+  }
+
   switch(config->mode) {
     case WIFI_MODE_NULL:
       return config_wifi_null(config);
@@ -14,6 +14,7 @@ struct wifi_config {
   bool config_only_mode;
   int mode; /* wifi_mode_t */
   int auth_mode; /* wifi_auth_mode_t */
+  int power_save; /* wifi_ps_type_t, or -1 for auto */
   uint16_t channel;
   char ssid[32];
   char password[64];
@@ -0,0 +1,14 @@
+export default class EventsService {
+    constructor(url) {
+      this.url = url;
+      this.eventSource = null;
+    }
+
+    subscribeMetrics(callback) {
+      if (!this.eventSource) {
+        this.eventSource = new EventSource(this.url);
+      }
+
+      this.eventSource.addEventListener('metrics', (event) => callback(JSON.parse(event.data)));
+    }
+  }
@@ -13,6 +13,11 @@ export default class SystemService {
 
     return response.data;
   }
+  async getHistory() {
+    const response = await this.apiService.get('/api/system/history');
+
+    return response.data;
+  }
 
   async restart() {
     const response = await this.apiService.post('/api/system/restart');
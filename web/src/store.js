@@ -5,6 +5,7 @@ import { createLogger } from 'vuex'
 import APIService from './services/api.service'
 import ArtNetService from './services/artnet.service'
 import ConfigService from './services/config.service'
+import EventsService from './services/events.service'
 import LedsService from './services/leds.service'
 import SystemService from './services/system.service'
 import UserService from './services/user.service'
@@ -14,6 +15,7 @@ import WiFiService from './services/wifi.service'
 const apiService = new APIService();
 const artnetService = new ArtNetService(apiService);
 const configService = new ConfigService(apiService);
+const eventsService = new EventsService('/api/events?interval=1000');
 const ledsService = new LedsService(apiService);
 const systemService = new SystemService(apiService);
 const userService = new UserService(apiService);
@@ -29,10 +31,12 @@ export default new Vuex.Store({
     artnet_outputs: null,
     config: null,
     configState: null,
+    events: false,
     leds: null,
     status_timestamp: 0,
     status: null,
     system: null,
+    system_history: null,
     wifi: null,
     wifi_scan: null,
     vfs: null,
@@ -79,6 +83,17 @@ export default new Vuex.Store({
       commit('loadStatus', status);
     },
 
+    /* events */
+    subscribeEvents({ state, commit }) {
+      if (state.events) {
+        return;
+      }
+
+      eventsService.subscribeMetrics((metrics) => commit('updateMetrics', metrics));
+
+      commit('subscribeEvents');
+    },
+
     /* config */
     async loadConfig({ commit }) {
       const config = await configService.get();
@@ -124,6 +139,11 @@ export default new Vuex.Store({
 
       commit('updateSystemTasks', data);
     },
+    async loadSystemHistory({ commit }) {
+      const data = await systemService.getHistory();
+
+      commit('updateSystemHistory', data);
+    },
     async restartSystem({ commit }) {
       await systemService.restart();
     },
@@ -215,6 +235,42 @@ export default new Vuex.Store({
       state.status = status;
     },
 
+    subscribeEvents (state) {
+      state.events = true;
+    },
+    updateMetrics (state, metrics) {
+      // keys are paths into the loaded API state, e.g. artnet_outputs.0.metrics.dmx_counter
+      for (const [key, value] of Object.entries(metrics)) {
+        const [root, ...path] = key.split('.');
+        const name = path.pop();
+        let object = state[root];
+
+        if (object instanceof Map) {
+          object = object.get(path.shift());
+        }
+
+        for (const member of path) {
+          if (!object) {
+            break;
+          }
+
+          object = object[member];
+        }
+
+        if (!object) {
+          // not loaded yet
+          continue;
+        }
+
+        Vue.set(object, name, value);
+      }
+
+      if (state.leds) {
+        // no reactive map support
+        state.leds = new Map(state.leds);
+      }
+    },
+
     loadConfig (state, config) {
       state.config = config;
       state.configState = config;
@@ -234,7 +290,8 @@ export default new Vuex.Store({
         }
       }
 
-      for (const task of tasks) {
+      // null if too many tasks
+      for (const task of tasks || []) {
         const prevTask = prevTasks.get(task.number);
 
         if (prevTask) {
@@ -245,6 +302,10 @@ export default new Vuex.Store({
 
       state.system.tasks = tasks;
     },
+    updateSystemHistory(state, history) {
+      // empty 204 response if disabled
+      state.system_history = history || null;
+    },
     updateWiFi(state, wifi) {
       state.wifi = wifi;
     },